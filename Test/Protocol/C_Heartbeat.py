@@ -0,0 +1,50 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: Protocol
+
+import flatbuffers
+from flatbuffers.compat import import_numpy
+np = import_numpy()
+
+class C_Heartbeat(object):
+    __slots__ = ['_tab']
+
+    @classmethod
+    def GetRootAs(cls, buf, offset=0):
+        n = flatbuffers.encode.Get(flatbuffers.packer.uoffset, buf, offset)
+        x = C_Heartbeat()
+        x.Init(buf, n + offset)
+        return x
+
+    @classmethod
+    def GetRootAsC_Heartbeat(cls, buf, offset=0):
+        """This method is deprecated. Please switch to GetRootAs."""
+        return cls.GetRootAs(buf, offset)
+    # C_Heartbeat
+    def Init(self, buf, pos):
+        self._tab = flatbuffers.table.Table(buf, pos)
+
+    # C_Heartbeat
+    def ClientTime(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint64Flags, o + self._tab.Pos)
+        return 0
+
+def C_HeartbeatStart(builder):
+    builder.StartObject(1)
+
+def Start(builder):
+    C_HeartbeatStart(builder)
+
+def C_HeartbeatAddClientTime(builder, clientTime):
+    builder.PrependUint64Slot(0, clientTime, 0)
+
+def AddClientTime(builder, clientTime):
+    C_HeartbeatAddClientTime(builder, clientTime)
+
+def C_HeartbeatEnd(builder):
+    return builder.EndObject()
+
+def End(builder):
+    return C_HeartbeatEnd(builder)
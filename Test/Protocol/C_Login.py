@@ -45,8 +45,15 @@ class C_Login(object):
             return self._tab.Get(flatbuffers.number_types.Int64Flags, o + self._tab.Pos)
         return 0
 
+    # C_Login
+    def AcceptLz4(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(10))
+        if o != 0:
+            return bool(self._tab.Get(flatbuffers.number_types.BoolFlags, o + self._tab.Pos))
+        return False
+
 def C_LoginStart(builder):
-    builder.StartObject(3)
+    builder.StartObject(4)
 
 def Start(builder):
     C_LoginStart(builder)
@@ -69,6 +76,12 @@ def C_LoginAddCommandId(builder, commandId):
 def AddCommandId(builder, commandId):
     C_LoginAddCommandId(builder, commandId)
 
+def C_LoginAddAcceptLz4(builder, acceptLz4):
+    builder.PrependBoolSlot(3, acceptLz4, 0)
+
+def AddAcceptLz4(builder, acceptLz4):
+    C_LoginAddAcceptLz4(builder, acceptLz4)
+
 def C_LoginEnd(builder):
     return builder.EndObject()
 
@@ -17,3 +17,5 @@ class Packet(object):
     S_ZoneEntered = 21
     S_PlayerJoined = 22
     S_PlayerLeft = 23
+    C_Heartbeat = 14
+    S_Heartbeat = 15
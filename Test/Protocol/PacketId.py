@@ -17,3 +17,5 @@ class PacketId(object):
     S_ZoneEntered = 21
     S_PlayerJoined = 22
     S_PlayerLeft = 23
+    C_Heartbeat = 30
+    S_Heartbeat = 31
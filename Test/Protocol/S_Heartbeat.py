@@ -0,0 +1,63 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: Protocol
+
+import flatbuffers
+from flatbuffers.compat import import_numpy
+np = import_numpy()
+
+class S_Heartbeat(object):
+    __slots__ = ['_tab']
+
+    @classmethod
+    def GetRootAs(cls, buf, offset=0):
+        n = flatbuffers.encode.Get(flatbuffers.packer.uoffset, buf, offset)
+        x = S_Heartbeat()
+        x.Init(buf, n + offset)
+        return x
+
+    @classmethod
+    def GetRootAsS_Heartbeat(cls, buf, offset=0):
+        """This method is deprecated. Please switch to GetRootAs."""
+        return cls.GetRootAs(buf, offset)
+    # S_Heartbeat
+    def Init(self, buf, pos):
+        self._tab = flatbuffers.table.Table(buf, pos)
+
+    # S_Heartbeat
+    def ClientTime(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint64Flags, o + self._tab.Pos)
+        return 0
+
+    # S_Heartbeat
+    def ServerTime(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint64Flags, o + self._tab.Pos)
+        return 0
+
+def S_HeartbeatStart(builder):
+    builder.StartObject(2)
+
+def Start(builder):
+    S_HeartbeatStart(builder)
+
+def S_HeartbeatAddClientTime(builder, clientTime):
+    builder.PrependUint64Slot(0, clientTime, 0)
+
+def AddClientTime(builder, clientTime):
+    S_HeartbeatAddClientTime(builder, clientTime)
+
+def S_HeartbeatAddServerTime(builder, serverTime):
+    builder.PrependUint64Slot(1, serverTime, 0)
+
+def AddServerTime(builder, serverTime):
+    S_HeartbeatAddServerTime(builder, serverTime)
+
+def S_HeartbeatEnd(builder):
+    return builder.EndObject()
+
+def End(builder):
+    return S_HeartbeatEnd(builder)
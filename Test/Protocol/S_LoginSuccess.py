@@ -42,8 +42,29 @@ class S_LoginSuccess(object):
             return self._tab.Get(flatbuffers.number_types.Int64Flags, o + self._tab.Pos)
         return 0
 
+    # S_LoginSuccess
+    def UdpToken(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(8))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint64Flags, o + self._tab.Pos)
+        return 0
+
+    # S_LoginSuccess
+    def UdpPort(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(10))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint16Flags, o + self._tab.Pos)
+        return 0
+
+    # S_LoginSuccess
+    def Lz4Enabled(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(12))
+        if o != 0:
+            return bool(self._tab.Get(flatbuffers.number_types.BoolFlags, o + self._tab.Pos))
+        return False
+
 def S_LoginSuccessStart(builder):
-    builder.StartObject(2)
+    builder.StartObject(5)
 
 def Start(builder):
     S_LoginSuccessStart(builder)
@@ -60,6 +81,24 @@ def S_LoginSuccessAddCommandId(builder, commandId):
 def AddCommandId(builder, commandId):
     S_LoginSuccessAddCommandId(builder, commandId)
 
+def S_LoginSuccessAddUdpToken(builder, udpToken):
+    builder.PrependUint64Slot(2, udpToken, 0)
+
+def AddUdpToken(builder, udpToken):
+    S_LoginSuccessAddUdpToken(builder, udpToken)
+
+def S_LoginSuccessAddUdpPort(builder, udpPort):
+    builder.PrependUint16Slot(3, udpPort, 0)
+
+def AddUdpPort(builder, udpPort):
+    S_LoginSuccessAddUdpPort(builder, udpPort)
+
+def S_LoginSuccessAddLz4Enabled(builder, lz4Enabled):
+    builder.PrependBoolSlot(4, lz4Enabled, 0)
+
+def AddLz4Enabled(builder, lz4Enabled):
+    S_LoginSuccessAddLz4Enabled(builder, lz4Enabled)
+
 def S_LoginSuccessEnd(builder):
     return builder.EndObject()
 
@@ -75,6 +75,7 @@ global_stats = {
     'zone_enter_failures': 0,
     'input_send_errors': 0,
     'snapshot_receive_errors': 0,
+    'input_latencies_ms': [],  # 입력 전송 → 해당 입력이 반영된 첫 스냅샷 수신
     'start_time': None,
     'errors': []
 }
@@ -97,6 +98,8 @@ class MovementLoadTestClient:
         self.session_ticket = account['session_ticket']
         self.username = account['username']
         self.sequence_number = 0
+        self.input_send_times = {}  # sequence_number -> perf_counter() 전송 시각
+        self.last_acked_sequence = 0
         
         # 통계
         self.connection_time = None
@@ -169,6 +172,7 @@ class MovementLoadTestClient:
         C_PlayerInput.C_PlayerInputAddInputFlags(builder, input_flags)
         C_PlayerInput.C_PlayerInputAddMousePosition(builder, mouse_pos_offset)
         C_PlayerInput.C_PlayerInputAddSequenceNumber(builder, self.sequence_number)
+        self.input_send_times[self.sequence_number] = time.perf_counter()
         C_PlayerInput.C_PlayerInputAddCommandId(builder, random.randint(1, 1000000))
         c_input_offset = C_PlayerInput.C_PlayerInputEnd(builder)
         
@@ -227,6 +231,7 @@ class MovementLoadTestClient:
             elif packet_id == PacketId.PacketId.S_ZoneEntered:
                 return 'zone_entered', None
             elif packet_id == PacketId.PacketId.S_WorldSnapshot:
+                self.record_input_latency(unified_packet)
                 return 'world_snapshot', None
             else:
                 return 'unknown', packet_id
@@ -235,6 +240,29 @@ class MovementLoadTestClient:
             self.errors.append(f"Parse error: {e}")
             return 'error', None
     
+    def record_input_latency(self, unified_packet):
+        """자기 PlayerState의 last_input_sequence로 입력→스냅샷 지연 측정"""
+        data_table = unified_packet.Data()
+        if not data_table:
+            return
+        snapshot = S_WorldSnapshot.S_WorldSnapshot()
+        snapshot.Init(data_table.Bytes, data_table.Pos)
+        for i in range(snapshot.PlayerStatesLength()):
+            state = snapshot.PlayerStates(i)
+            if state.PlayerId() != self.player_id:
+                continue
+            acked = state.LastInputSequence()
+            if acked > self.last_acked_sequence:
+                sent_at = self.input_send_times.get(acked)
+                if sent_at is not None:
+                    with stats_lock:
+                        global_stats['input_latencies_ms'].append((time.perf_counter() - sent_at) * 1000.0)
+                # 확인된 시퀀스까지의 전송 기록 정리
+                for seq in range(self.last_acked_sequence + 1, acked + 1):
+                    self.input_send_times.pop(seq, None)
+                self.last_acked_sequence = acked
+            break
+    
     def connect_and_setup(self) -> bool:
         """연결 및 초기 설정"""
         try:
@@ -423,6 +451,14 @@ class MovementLoadTestClient:
             'error_messages': self.errors[:5]  # 처음 5개 에러만 저장
         })
 
+def latency_percentiles(samples):
+    """p50/p95/p99 (ms), 샘플이 없으면 None"""
+    if not samples:
+        return None
+    ordered = sorted(samples)
+    pick = lambda q: ordered[min(len(ordered) - 1, int(q * len(ordered)))]
+    return pick(0.50), pick(0.95), pick(0.99)
+
 def print_realtime_stats():
     """실시간 통계 출력 및 CSV 로깅"""
     start_time = time.time()
@@ -434,7 +470,8 @@ def print_realtime_stats():
     with open(csv_filename, 'w', newline='', encoding='utf-8') as csvfile:
         fieldnames = ['elapsed_time', 'clients_connected', 'clients_in_zone', 
                      'total_inputs_sent', 'inputs_per_sec', 'total_snapshots_received', 
-                     'snapshots_per_sec', 'input_errors', 'snapshot_errors']
+                     'snapshots_per_sec', 'input_errors', 'snapshot_errors',
+                     'input_latency_p50_ms', 'input_latency_p95_ms', 'input_latency_p99_ms']
         writer = csv.DictWriter(csvfile, fieldnames=fieldnames)
         writer.writeheader()
         
@@ -445,6 +482,9 @@ def print_realtime_stats():
                 elapsed = time.time() - global_stats['start_time']
                 inputs_per_sec = global_stats['total_inputs_sent'] / elapsed if elapsed > 0 else 0
                 snapshots_per_sec = global_stats['total_snapshots_received'] / elapsed if elapsed > 0 else 0
+                # 구간별 지연: 직전 출력 이후 샘플만 사용
+                latency = latency_percentiles(global_stats['input_latencies_ms'])
+                global_stats['input_latencies_ms'] = []
                 
                 stats_row = {
                     'elapsed_time': f"{elapsed:.0f}",
@@ -455,7 +495,10 @@ def print_realtime_stats():
                     'total_snapshots_received': global_stats['total_snapshots_received'],
                     'snapshots_per_sec': f"{snapshots_per_sec:.1f}",
                     'input_errors': global_stats['input_send_errors'],
-                    'snapshot_errors': global_stats['snapshot_receive_errors']
+                    'snapshot_errors': global_stats['snapshot_receive_errors'],
+                    'input_latency_p50_ms': f"{latency[0]:.2f}" if latency else '',
+                    'input_latency_p95_ms': f"{latency[1]:.2f}" if latency else '',
+                    'input_latency_p99_ms': f"{latency[2]:.2f}" if latency else ''
                 }
                 
                 writer.writerow(stats_row)
@@ -468,6 +511,8 @@ def print_realtime_stats():
                 print(f"  총 스냅샷 수신: {global_stats['total_snapshots_received']} ({snapshots_per_sec:.1f}/s)")
                 print(f"  입력 전송 오류: {global_stats['input_send_errors']}")
                 print(f"  스냅샷 수신 오류: {global_stats['snapshot_receive_errors']}") 
+                if latency:
+                    print(f"  입력→스냅샷 지연 p50/p95/p99: {latency[0]:.2f} / {latency[1]:.2f} / {latency[2]:.2f} ms")
                 
     print(f"\n실시간 통계가 {csv_filename}에 저장되었습니다.")
 
@@ -0,0 +1,241 @@
+// Accept throughput during a connect storm.
+//
+// Models the TcpServer accept path under a burst of N simultaneous connects (everyone reconnecting
+// after a restart). Each accepted socket gets the same kind of setup work the server does: socket
+// options, an allocation, an insert into a mutex-guarded session map and `setup_us` of busy work
+// standing in for Session construction, logging and the connect callbacks. Two pipelines are timed
+// over loopback on one io_context run by `io_threads` threads (IoMode::Shared):
+//   inline   - one accept coroutine that finishes setup before accepting the next socket
+//   parallel - `accept_concurrency` accept coroutines on the same acceptor, serialized on its strand
+//              as in TcpServer; setup is posted to the plain context so the accepting coroutine goes
+//              straight back to async_accept
+//
+// Reports accepted sessions per second (first connect to last completed setup) and how many
+// connects failed. Raise net.core.somaxconn to the burst size, otherwise SYN retransmits at 1s
+// dominate both runs.
+//
+// Usage: accept_burst_bench [clients=5000] [io_threads=4] [accept_concurrency=4] [setup_us=20] [client_threads=2]
+
+#include <boost/asio.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace asio = boost::asio;
+namespace ip = asio::ip;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    struct Options
+    {
+        size_t clients = 5000;
+        int ioThreads = 4;
+        size_t acceptConcurrency = 4;
+        int setupMicros = 20;
+        int clientThreads = 2;
+    };
+
+    struct Result
+    {
+        double acceptsPerSecond = 0.0;
+        double seconds = 0.0;
+        size_t accepted = 0;
+        size_t failed = 0;
+    };
+
+    struct Connection
+    {
+        explicit Connection(ip::tcp::socket s) : socket(std::move(s)) {}
+        ip::tcp::socket socket;
+        std::vector<char> buffer = std::vector<char>(256);
+    };
+
+    class Server
+    {
+    public:
+        Server(const Options& options, bool parallel)
+            : m_io(options.ioThreads), m_acceptor(asio::make_strand(m_io)), m_options(options)
+        {
+            ip::tcp::endpoint endpoint(ip::address_v4::loopback(), 0);
+            m_acceptor.open(endpoint.protocol());
+            m_acceptor.set_option(ip::tcp::acceptor::reuse_address(true));
+            m_acceptor.bind(endpoint);
+            m_acceptor.listen(asio::socket_base::max_listen_connections);
+
+            size_t loops = parallel ? options.acceptConcurrency : 1;
+            for (size_t i = 0; i < loops; ++i)
+            {
+                asio::co_spawn(m_acceptor.get_executor(), AcceptLoop(parallel), asio::detached);
+            }
+            for (int i = 0; i < options.ioThreads; ++i)
+            {
+                m_threads.emplace_back([this]() { m_io.run(); });
+            }
+        }
+
+        ~Server()
+        {
+            m_io.stop();
+            for (auto& thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+
+        unsigned short Port() const { return m_acceptor.local_endpoint().port(); }
+        size_t Accepted() const { return m_accepted.load(std::memory_order_acquire); }
+        Clock::time_point LastSetup() const { return Clock::time_point(Clock::duration(m_lastSetup.load(std::memory_order_acquire))); }
+
+    private:
+        asio::awaitable<void> AcceptLoop(bool parallel)
+        {
+            try
+            {
+                for (;;)
+                {
+                    ip::tcp::socket socket(m_io);
+                    ip::tcp::endpoint peer;
+                    co_await m_acceptor.async_accept(socket, peer, asio::use_awaitable);
+                    if (parallel)
+                    {
+                        asio::post(m_io, [this, socket = std::move(socket)]() mutable { Setup(std::move(socket)); });
+                    }
+                    else
+                    {
+                        Setup(std::move(socket));
+                    }
+                }
+            }
+            catch (const std::exception&)
+            {
+            }
+        }
+
+        void Setup(ip::tcp::socket socket)
+        {
+            boost::system::error_code ec;
+            socket.set_option(asio::socket_base::linger(false, 0), ec);
+            socket.set_option(ip::tcp::no_delay(true), ec);
+            auto connection = std::make_shared<Connection>(std::move(socket));
+
+            auto until = Clock::now() + std::chrono::microseconds(m_options.setupMicros);
+            while (Clock::now() < until)
+            {
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_connections.emplace(m_nextId++, connection);
+            }
+
+            // Park a read like Session::Start does, so the socket stays registered with the reactor
+            connection->socket.async_read_some(asio::buffer(connection->buffer),
+                [connection](const boost::system::error_code&, size_t) {});
+
+            auto now = Clock::now().time_since_epoch().count();
+            auto last = m_lastSetup.load(std::memory_order_relaxed);
+            while (last < now && !m_lastSetup.compare_exchange_weak(last, now, std::memory_order_release))
+            {
+            }
+            m_accepted.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        asio::io_context m_io;
+        ip::tcp::acceptor m_acceptor;
+        const Options& m_options;
+        std::vector<std::thread> m_threads;
+        std::mutex m_mutex;
+        std::unordered_map<uint64_t, std::shared_ptr<Connection>> m_connections;
+        uint64_t m_nextId = 0;
+        std::atomic<size_t> m_accepted{0};
+        std::atomic<Clock::rep> m_lastSetup{0};
+    };
+
+    Result Run(const Options& options, bool parallel)
+    {
+        Server server(options, parallel);
+        ip::tcp::endpoint endpoint(ip::address_v4::loopback(), server.Port());
+
+        asio::io_context client(options.clientThreads);
+        std::vector<ip::tcp::socket> sockets;
+        sockets.reserve(options.clients);
+        for (size_t i = 0; i < options.clients; ++i)
+        {
+            sockets.emplace_back(client);
+        }
+
+        // connect() is issued inside async_connect, so the burst starts here, not when the threads run
+        std::atomic<size_t> failed{0};
+        auto start = Clock::now();
+        for (auto& socket : sockets)
+        {
+            socket.async_connect(endpoint, [&failed](const boost::system::error_code& ec)
+            {
+                if (ec)
+                {
+                    failed.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        std::vector<std::thread> threads;
+        for (int i = 0; i < options.clientThreads; ++i)
+        {
+            threads.emplace_back([&client]() { client.run(); });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        // Connects complete on the handshake; wait for the server to finish setting up the rest
+        size_t expected = options.clients - failed.load();
+        auto giveUp = Clock::now() + std::chrono::seconds(10);
+        while (server.Accepted() < expected && Clock::now() < giveUp)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        Result result;
+        result.accepted = server.Accepted();
+        result.failed = failed.load();
+        result.seconds = std::chrono::duration<double>(server.LastSetup() - start).count();
+        result.acceptsPerSecond = result.seconds > 0.0 ? result.accepted / result.seconds : 0.0;
+
+        for (auto& socket : sockets)
+        {
+            boost::system::error_code ec;
+            socket.close(ec);
+        }
+        return result;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (argc > 1) options.clients = std::strtoull(argv[1], nullptr, 10);
+    if (argc > 2) options.ioThreads = std::max(1, std::atoi(argv[2]));
+    if (argc > 3) options.acceptConcurrency = std::max<size_t>(1, std::strtoull(argv[3], nullptr, 10));
+    if (argc > 4) options.setupMicros = std::atoi(argv[4]);
+    if (argc > 5) options.clientThreads = std::max(1, std::atoi(argv[5]));
+
+    std::printf("clients=%zu io_threads=%d accept_concurrency=%zu setup_us=%d client_threads=%d\n",
+                options.clients, options.ioThreads, options.acceptConcurrency, options.setupMicros, options.clientThreads);
+
+    const struct { const char* name; bool parallel; } pipelines[] = { { "inline", false }, { "parallel", true } };
+    for (const auto& pipeline : pipelines)
+    {
+        Result result = Run(options, pipeline.parallel);
+        std::printf("%-9s accepted %zu in %.3fs  accepts/sec %10.0f  failed connects %zu\n",
+                    pipeline.name, result.accepted, result.seconds, result.acceptsPerSecond, result.failed);
+    }
+    return 0;
+}
@@ -0,0 +1,281 @@
+// Benchmark for the network backend (epoll reactor vs io_uring).
+//
+// The same source is built twice: backend_bench_epoll with asio's default reactor, and
+// backend_bench_uring with BOOST_ASIO_HAS_IO_URING + BOOST_ASIO_DISABLE_EPOLL. In the io_uring build
+// the echo server reads into chunks of a registered arena, as Session does with
+// RegisteredReceivePool.
+//
+// N simulated clients each send one length-prefixed frame at a fixed rate (like C_PlayerInput);
+// the server echoes whole frames back. Reports achieved messages/sec, round-trip percentiles and
+// process CPU time per message. Client and server share the process, so compare the two binaries
+// with identical arguments rather than reading absolute numbers.
+//
+// Usage: backend_bench_<backend> [clients=1000] [seconds=10] [rate_hz=30] [payload=64] [server_threads=2] [client_threads=2]
+
+#include <boost/asio.hpp>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace asio = boost::asio;
+namespace ip = asio::ip;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+#ifdef BOOST_ASIO_HAS_IO_URING
+    constexpr const char* BACKEND_NAME = "io_uring";
+#else
+    constexpr const char* BACKEND_NAME = "epoll";
+#endif
+
+    constexpr size_t RECEIVE_CHUNK_SIZE = 4096;
+
+    struct Options
+    {
+        size_t clients = 1000;
+        int seconds = 10;
+        int rateHz = 30;
+        size_t payload = 64;
+        int serverThreads = 2;
+        int clientThreads = 2;
+    };
+
+    double CpuSeconds()
+    {
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        auto toSeconds = [](const timeval& tv) { return tv.tv_sec + tv.tv_usec / 1e6; };
+        return toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+    }
+
+    // Receive arena; registered with the server io_context in the io_uring build
+    class ReceiveArena
+    {
+    public:
+        ReceiveArena(asio::io_context& io, size_t chunkCount)
+            : m_arena(std::make_unique<char[]>(chunkCount * RECEIVE_CHUNK_SIZE))
+        {
+            for (size_t i = 0; i < chunkCount; ++i)
+            {
+                m_chunks.emplace_back(m_arena.get() + i * RECEIVE_CHUNK_SIZE, RECEIVE_CHUNK_SIZE);
+            }
+#ifdef BOOST_ASIO_HAS_IO_URING
+            m_registration.emplace(asio::register_buffers(io, m_chunks));
+#else
+            (void)io;
+#endif
+        }
+
+        char* Data(size_t index) const { return static_cast<char*>(m_chunks[index].data()); }
+
+        template <typename Socket>
+        auto ReadSome(Socket& socket, size_t index, size_t offset, size_t size)
+        {
+#ifdef BOOST_ASIO_HAS_IO_URING
+            auto registered = *(m_registration->begin() + index) + offset;
+            return socket.async_read_some(asio::buffer(registered, size), asio::use_awaitable);
+#else
+            return socket.async_read_some(asio::buffer(Data(index) + offset, size), asio::use_awaitable);
+#endif
+        }
+
+    private:
+        std::unique_ptr<char[]> m_arena;
+        std::vector<asio::mutable_buffer> m_chunks;
+#ifdef BOOST_ASIO_HAS_IO_URING
+        std::optional<asio::buffer_registration<std::vector<asio::mutable_buffer>>> m_registration;
+#endif
+    };
+
+    // Frames here always fit a chunk, so the parse loop only compacts (Session also grows)
+    asio::awaitable<void> EchoSession(ip::tcp::socket socket, ReceiveArena& arena, size_t chunkIndex)
+    {
+        char* base = arena.Data(chunkIndex);
+        size_t readPos = 0;
+        size_t writePos = 0;
+        try
+        {
+            for (;;)
+            {
+                if (RECEIVE_CHUNK_SIZE - writePos < 1024)
+                {
+                    std::memmove(base, base + readPos, writePos - readPos);
+                    writePos -= readPos;
+                    readPos = 0;
+                }
+                size_t bytes = co_await arena.ReadSome(socket, chunkIndex, writePos, RECEIVE_CHUNK_SIZE - writePos);
+                writePos += bytes;
+
+                size_t frameStart = readPos;
+                while (writePos - readPos >= sizeof(uint32_t))
+                {
+                    uint32_t length = 0;
+                    std::memcpy(&length, base + readPos, sizeof(length));
+                    if (writePos - readPos < sizeof(length) + length)
+                    {
+                        break;
+                    }
+                    readPos += sizeof(length) + length;
+                }
+                if (readPos > frameStart)
+                {
+                    co_await asio::async_write(socket, asio::buffer(base + frameStart, readPos - frameStart), asio::use_awaitable);
+                }
+                if (readPos == writePos)
+                {
+                    readPos = writePos = 0;
+                }
+            }
+        }
+        catch (const std::exception&)
+        {
+        }
+    }
+
+    asio::awaitable<void> AcceptLoop(ip::tcp::acceptor& acceptor, ReceiveArena& arena, size_t chunkCount)
+    {
+        size_t nextChunk = 0;
+        try
+        {
+            for (;;)
+            {
+                ip::tcp::socket socket = co_await acceptor.async_accept(asio::use_awaitable);
+                socket.set_option(ip::tcp::no_delay(true));
+                auto executor = socket.get_executor();
+                asio::co_spawn(executor, EchoSession(std::move(socket), arena, nextChunk++ % chunkCount), asio::detached);
+            }
+        }
+        catch (const std::exception&)
+        {
+        }
+    }
+
+    struct ClientStats
+    {
+        std::mutex mutex;
+        std::vector<uint32_t> rttUs;
+        uint64_t messages = 0;
+    };
+
+    asio::awaitable<void> Client(ip::tcp::endpoint endpoint, const Options& options, Clock::time_point start,
+                                 Clock::time_point deadline, ClientStats& stats)
+    {
+        auto executor = co_await asio::this_coro::executor;
+        ip::tcp::socket socket(executor);
+        asio::steady_timer timer(executor);
+        std::vector<uint32_t> rtts;
+        rtts.reserve(static_cast<size_t>(options.seconds * options.rateHz) + 1);
+
+        try
+        {
+            co_await socket.async_connect(endpoint, asio::use_awaitable);
+            socket.set_option(ip::tcp::no_delay(true));
+
+            std::vector<char> frame(sizeof(uint32_t) + options.payload, 'x');
+            uint32_t length = static_cast<uint32_t>(options.payload);
+            std::memcpy(frame.data(), &length, sizeof(length));
+            std::vector<char> reply(frame.size());
+
+            auto interval = std::chrono::microseconds(1000000 / std::max(1, options.rateHz));
+            auto next = start;
+            while (next < deadline)
+            {
+                timer.expires_at(next);
+                co_await timer.async_wait(asio::use_awaitable);
+
+                auto sent = Clock::now();
+                co_await asio::async_write(socket, asio::buffer(frame), asio::use_awaitable);
+                co_await asio::async_read(socket, asio::buffer(reply), asio::use_awaitable);
+                rtts.push_back(static_cast<uint32_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - sent).count()));
+                next += interval;
+            }
+        }
+        catch (const std::exception&)
+        {
+        }
+
+        std::lock_guard<std::mutex> lock(stats.mutex);
+        stats.messages += rtts.size();
+        stats.rttUs.insert(stats.rttUs.end(), rtts.begin(), rtts.end());
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (argc > 1) options.clients = std::strtoull(argv[1], nullptr, 10);
+    if (argc > 2) options.seconds = std::atoi(argv[2]);
+    if (argc > 3) options.rateHz = std::atoi(argv[3]);
+    if (argc > 4) options.payload = std::strtoull(argv[4], nullptr, 10);
+    if (argc > 5) options.serverThreads = std::atoi(argv[5]);
+    if (argc > 6) options.clientThreads = std::atoi(argv[6]);
+
+    asio::io_context server(options.serverThreads);
+    ip::tcp::acceptor acceptor(server, ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+    acceptor.listen(asio::socket_base::max_listen_connections);
+    ip::tcp::endpoint endpoint = acceptor.local_endpoint();
+
+    ReceiveArena arena(server, options.clients);
+    asio::co_spawn(server, AcceptLoop(acceptor, arena, options.clients), asio::detached);
+
+    std::vector<std::thread> serverThreads;
+    for (int i = 0; i < options.serverThreads; ++i)
+    {
+        serverThreads.emplace_back([&server]() { server.run(); });
+    }
+
+    // Clients start spread over one send interval so they do not fire in lockstep
+    asio::io_context client(options.clientThreads);
+    ClientStats stats;
+    auto start = Clock::now() + std::chrono::seconds(1);
+    auto deadline = start + std::chrono::seconds(options.seconds);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> jitterUs(0, 1000000 / std::max(1, options.rateHz));
+    for (size_t i = 0; i < options.clients; ++i)
+    {
+        asio::co_spawn(client, Client(endpoint, options, start + std::chrono::microseconds(jitterUs(rng)), deadline, stats),
+                       asio::detached);
+    }
+
+    double cpuStart = CpuSeconds();
+    std::vector<std::thread> clientThreads;
+    for (int i = 0; i < options.clientThreads; ++i)
+    {
+        clientThreads.emplace_back([&client]() { client.run(); });
+    }
+    for (auto& thread : clientThreads)
+    {
+        thread.join();
+    }
+    double cpuSeconds = CpuSeconds() - cpuStart;
+
+    server.stop();
+    for (auto& thread : serverThreads)
+    {
+        thread.join();
+    }
+
+    auto& rtt = stats.rttUs;
+    std::sort(rtt.begin(), rtt.end());
+    auto percentile = [&rtt](double p) {
+        return rtt.empty() ? 0u : rtt[std::min(rtt.size() - 1, static_cast<size_t>(p * rtt.size()))];
+    };
+    double messages = static_cast<double>(stats.messages);
+    std::printf("%-8s clients %6zu  msgs/sec %9.0f  rtt p50 %6u us  p99 %6u us  p99.9 %6u us  max %7u us  cpu/msg %6.2f us\n",
+                BACKEND_NAME, options.clients, messages / options.seconds,
+                percentile(0.50), percentile(0.99), percentile(0.999), percentile(1.0),
+                messages > 0 ? cpuSeconds * 1e6 / messages : 0.0);
+    return 0;
+}
@@ -0,0 +1,210 @@
+// Game command hand-off: GameCommand through the MPMC queue vs CompactGameCommand through per-producer SPSC rings.
+//
+// `producers` threads (I/O threads and packet workers) each push `commands` player inputs while
+// the game thread drains in chunks of 64, the way GameManager::ProcessPendingCommands does:
+//   mpmc    - GameCommand (variant payload that can hold strings and vectors) in a
+//             moodycamel::ConcurrentQueue with ProducerTokens, drained with try_dequeue_bulk
+//   compact - CompactGameCommand copied into one SpscRing per producer, drained by a round-robin
+//             sweep (GameLogicQueue::TryPopCompactCommands)
+//
+// Reports bytes per command, end-to-end commands per second and the game thread's drain cost per
+// command (time inside the dequeue calls and the field reads, excluding empty polls).
+//
+// Usage: command_queue_bench [producers=4] [commands=2000000]
+
+#include <concurrentqueue.h>
+#include "Game/CompactGameCommand.h"
+#include "Utils/SpscRing.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using CppMMO::Game::CompactCommandType;
+using CppMMO::Game::CompactGameCommand;
+
+namespace
+{
+    constexpr size_t DRAIN_CHUNK = 64;
+    constexpr size_t RING_CAPACITY = 4096;
+
+    // Same shape as Game::GameCommand; the server header needs the pch and generated protocol
+    struct Vec3 { float x = 0.0f, y = 0.0f, z = 0.0f; };
+    struct PlayerInputCommandData { uint64_t playerId = 0; uint64_t tickNumber = 0; uint64_t clientTime = 0; uint8_t inputFlags = 0; Vec3 mousePosition{}; uint32_t sequenceNumber = 0; int64_t sessionId = 0; };
+    struct EnterZoneCommandData { uint64_t playerId = 0; int zoneId = 0; int64_t sessionId = 0; };
+    struct PlayerSpawnCommandData { uint64_t playerId = 0; std::string playerName; Vec3 spawnPosition{}; int hp = 100, maxHp = 100, mp = 50, maxMp = 50; };
+    struct PlayerDisconnectCommandData { uint64_t playerId = 0; };
+    struct WorldRestoreCommandData { uint64_t tickNumber = 0; std::vector<PlayerSpawnCommandData> players; };
+    struct GameCommand
+    {
+        int64_t commandId = 0;
+        std::variant<PlayerInputCommandData, EnterZoneCommandData, PlayerSpawnCommandData, PlayerDisconnectCommandData, WorldRestoreCommandData> payload{};
+        int64_t senderSessionId = 0;
+        uint64_t timestamp = 0;
+        int64_t receivedAtUs = 0;
+    };
+
+    struct Result
+    {
+        double commandsPerSecond = 0.0;
+        double drainNsPerCommand = 0.0;
+        uint64_t checksum = 0;
+    };
+
+    Result RunMpmc(int producers, size_t perProducer)
+    {
+        moodycamel::ConcurrentQueue<GameCommand> queue;
+        std::vector<std::thread> threads;
+        auto start = Clock::now();
+        for (int p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&queue, p, perProducer]()
+            {
+                moodycamel::ProducerToken token(queue);
+                for (size_t i = 0; i < perProducer; ++i)
+                {
+                    GameCommand command;
+                    command.senderSessionId = p;
+                    PlayerInputCommandData data;
+                    data.playerId = static_cast<uint64_t>(p);
+                    data.inputFlags = static_cast<uint8_t>(i);
+                    data.sequenceNumber = static_cast<uint32_t>(i);
+                    command.payload = data;
+                    queue.enqueue(token, std::move(command));
+                }
+            });
+        }
+
+        Result result;
+        std::vector<GameCommand> buffer(DRAIN_CHUNK);
+        moodycamel::ConsumerToken consumer(queue);
+        size_t total = perProducer * producers;
+        size_t drained = 0;
+        Clock::duration drainTime{};
+        while (drained < total)
+        {
+            auto chunkStart = Clock::now();
+            size_t count = queue.try_dequeue_bulk(consumer, buffer.data(), buffer.size());
+            if (count == 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            for (size_t i = 0; i < count; ++i)
+            {
+                const auto& data = std::get<PlayerInputCommandData>(buffer[i].payload);
+                result.checksum += data.sequenceNumber + data.inputFlags;
+            }
+            drainTime += Clock::now() - chunkStart;
+            drained += count;
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        result.commandsPerSecond = total / seconds;
+        result.drainNsPerCommand = std::chrono::duration<double, std::nano>(drainTime).count() / total;
+        return result;
+    }
+
+    Result RunCompact(int producers, size_t perProducer)
+    {
+        using Ring = CppMMO::Utils::SpscRing<CompactGameCommand, RING_CAPACITY>;
+        std::vector<std::unique_ptr<Ring>> rings;
+        for (int p = 0; p < producers; ++p)
+        {
+            rings.push_back(std::make_unique<Ring>());
+        }
+
+        std::vector<std::thread> threads;
+        auto start = Clock::now();
+        for (int p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([ring = rings[p].get(), p, perProducer]()
+            {
+                for (size_t i = 0; i < perProducer; ++i)
+                {
+                    CompactGameCommand command;
+                    command.type = CompactCommandType::PlayerInput;
+                    command.sessionId = p;
+                    command.playerId = static_cast<uint64_t>(p);
+                    command.inputFlags = static_cast<uint8_t>(i);
+                    command.sequenceNumber = static_cast<uint32_t>(i);
+                    // The server spills into the lane's overflow list here; the bench waits instead
+                    while (!ring->TryPush(command))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        Result result;
+        std::array<CompactGameCommand, DRAIN_CHUNK> buffer{};
+        size_t total = perProducer * producers;
+        size_t drained = 0;
+        size_t sweepStart = 0;
+        size_t share = std::max<size_t>(1, DRAIN_CHUNK / rings.size());
+        Clock::duration drainTime{};
+        while (drained < total)
+        {
+            auto chunkStart = Clock::now();
+            size_t count = 0;
+            for (size_t i = 0; i < rings.size() && count < DRAIN_CHUNK; ++i)
+            {
+                count += rings[(sweepStart + i) % rings.size()]->TryPopBulk(buffer.data() + count, std::min(share, DRAIN_CHUNK - count));
+            }
+            sweepStart = (sweepStart + 1) % rings.size();
+            if (count == 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            for (size_t i = 0; i < count; ++i)
+            {
+                result.checksum += buffer[i].sequenceNumber + buffer[i].inputFlags;
+            }
+            drainTime += Clock::now() - chunkStart;
+            drained += count;
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        result.commandsPerSecond = total / seconds;
+        result.drainNsPerCommand = std::chrono::duration<double, std::nano>(drainTime).count() / total;
+        return result;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int producers = 4;
+    size_t commands = 2000000;
+    if (argc > 1) producers = std::max(1, std::atoi(argv[1]));
+    if (argc > 2) commands = std::strtoull(argv[2], nullptr, 10);
+    size_t perProducer = std::max<size_t>(1, commands / producers);
+
+    std::printf("producers=%d commands=%zu\n", producers, perProducer * producers);
+    std::printf("bytes/command: mpmc %zu (GameCommand), compact %zu (CompactGameCommand)\n",
+                sizeof(GameCommand), sizeof(CompactGameCommand));
+
+    Result mpmc = RunMpmc(producers, perProducer);
+    Result compact = RunCompact(producers, perProducer);
+    std::printf("mpmc     commands/sec %11.0f  drain %6.1f ns/command  (checksum %llu)\n",
+                mpmc.commandsPerSecond, mpmc.drainNsPerCommand, static_cast<unsigned long long>(mpmc.checksum));
+    std::printf("compact  commands/sec %11.0f  drain %6.1f ns/command  (checksum %llu)\n",
+                compact.commandsPerSecond, compact.drainNsPerCommand, static_cast<unsigned long long>(compact.checksum));
+    return 0;
+}
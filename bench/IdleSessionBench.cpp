@@ -0,0 +1,241 @@
+// Idle connection footprint benchmark.
+//
+// Opens N loopback connections to a running game server, never sends on them, and reports how much
+// the server's resident set grew per connection. Run the server first with max_connections >= N,
+// read_idle_timeout_ms of 0 (or longer than the hold time) and a raised open file limit, e.g.
+//
+//   ulimit -n 200000
+//   ./CppMMO_Deployment --io-threads 4 &
+//   idle_session_bench 50000 $!
+//
+// Client sockets are spread over several 127.0.0.x source addresses so 50k connections do not run
+// out of ephemeral ports. The server-side figure includes everything a connection costs in user
+// space (Session, coroutine frame, reaper and session manager entries, allocator overhead); kernel
+// socket memory is reported separately from /proc/net/sockstat.
+//
+// Usage: idle_session_bench [connections=50000] [server_pid] [port=8080] [hold_seconds=5] [in_flight=64]
+
+#include <boost/asio.hpp>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace asio = boost::asio;
+namespace ip = asio::ip;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    constexpr size_t SOURCE_ADDRESSES = 8;   // 127.0.0.2 .. 127.0.0.9
+
+    struct Options
+    {
+        size_t connections = 50000;
+        long serverPid = 0;
+        unsigned short port = 8080;
+        int holdSeconds = 5;
+        size_t inFlight = 64;
+    };
+
+    // VmRSS of `pid` in bytes, or 0 if it cannot be read
+    size_t ResidentBytes(long pid)
+    {
+        std::ifstream status("/proc/" + std::to_string(pid) + "/status");
+        std::string line;
+        while (std::getline(status, line))
+        {
+            if (line.rfind("VmRSS:", 0) == 0)
+            {
+                return std::strtoull(line.c_str() + 6, nullptr, 10) * 1024;
+            }
+        }
+        return 0;
+    }
+
+    // Pages of memory the kernel has charged to TCP sockets
+    size_t TcpSocketPages()
+    {
+        std::ifstream sockstat("/proc/net/sockstat");
+        std::string line;
+        while (std::getline(sockstat, line))
+        {
+            if (line.rfind("TCP:", 0) == 0)
+            {
+                auto pos = line.find(" mem ");
+                return pos == std::string::npos ? 0 : std::strtoull(line.c_str() + pos + 5, nullptr, 10);
+            }
+        }
+        return 0;
+    }
+
+    void RaiseFileLimit()
+    {
+        rlimit limit{};
+        if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max)
+        {
+            limit.rlim_cur = limit.rlim_max;
+            setrlimit(RLIMIT_NOFILE, &limit);
+        }
+    }
+
+    class Connector
+    {
+    public:
+        Connector(asio::io_context& io, const Options& options)
+            : m_io(io), m_options(options)
+        {
+            m_sockets.reserve(options.connections);
+        }
+
+        void Run()
+        {
+            Launch();
+            m_io.run();
+        }
+
+        std::vector<std::unique_ptr<ip::tcp::socket>>& Sockets() { return m_sockets; }
+        size_t Failures() const { return m_failures; }
+
+    private:
+        void Launch()
+        {
+            while (m_inFlight < m_options.inFlight && m_started < m_options.connections)
+            {
+                size_t index = m_started++;
+                auto socket = std::make_unique<ip::tcp::socket>(m_io);
+                boost::system::error_code ec;
+                socket->open(ip::tcp::v4(), ec);
+#ifdef IP_BIND_ADDRESS_NO_PORT
+                // Let connect() pick the port per 4-tuple instead of reserving one per bind
+                int one = 1;
+                setsockopt(socket->native_handle(), IPPROTO_IP, IP_BIND_ADDRESS_NO_PORT, &one, sizeof(one));
+#endif
+                auto source = ip::make_address_v4(static_cast<ip::address_v4::uint_type>(0x7F000002 + index % SOURCE_ADDRESSES));
+                socket->bind(ip::tcp::endpoint(source, 0), ec);
+                if (ec)
+                {
+                    ++m_failures;
+                    continue;
+                }
+
+                ++m_inFlight;
+                auto* raw = socket.get();
+                raw->async_connect(ip::tcp::endpoint(ip::address_v4::loopback(), m_options.port),
+                    [this, socket = std::move(socket)](const boost::system::error_code& error) mutable
+                    {
+                        --m_inFlight;
+                        if (error)
+                        {
+                            if (m_failures++ == 0)
+                            {
+                                std::printf("connect failed: %s\n", error.message().c_str());
+                            }
+                        }
+                        else
+                        {
+                            m_sockets.push_back(std::move(socket));
+                            if (m_sockets.size() % 10000 == 0)
+                            {
+                                std::printf("  %zu connected\n", m_sockets.size());
+                            }
+                        }
+                        Launch();
+                    });
+            }
+        }
+
+        asio::io_context& m_io;
+        const Options& m_options;
+        std::vector<std::unique_ptr<ip::tcp::socket>> m_sockets;
+        size_t m_started = 0;
+        size_t m_inFlight = 0;
+        size_t m_failures = 0;
+    };
+
+    // Counts connections the server has already closed (rejected over the cap or reaped)
+    size_t CountClosedByServer(std::vector<std::unique_ptr<ip::tcp::socket>>& sockets)
+    {
+        size_t closed = 0;
+        char byte = 0;
+        for (auto& socket : sockets)
+        {
+            boost::system::error_code ec;
+            socket->non_blocking(true, ec);
+            socket->read_some(asio::buffer(&byte, 1), ec);
+            if (ec && ec != asio::error::would_block)
+            {
+                ++closed;
+            }
+        }
+        return closed;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (argc > 1) options.connections = std::strtoull(argv[1], nullptr, 10);
+    if (argc > 2) options.serverPid = std::strtol(argv[2], nullptr, 10);
+    if (argc > 3) options.port = static_cast<unsigned short>(std::atoi(argv[3]));
+    if (argc > 4) options.holdSeconds = std::atoi(argv[4]);
+    if (argc > 5) options.inFlight = std::strtoull(argv[5], nullptr, 10);
+
+    if (options.serverPid <= 0)
+    {
+        std::fprintf(stderr, "usage: %s [connections] <server_pid> [port] [hold_seconds] [in_flight]\n", argv[0]);
+        return 1;
+    }
+
+    RaiseFileLimit();
+
+    size_t rssBefore = ResidentBytes(options.serverPid);
+    size_t tcpPagesBefore = TcpSocketPages();
+    if (rssBefore == 0)
+    {
+        std::fprintf(stderr, "cannot read /proc/%ld/status\n", options.serverPid);
+        return 1;
+    }
+
+    std::printf("Opening %zu idle connections to 127.0.0.1:%u (server pid %ld, baseline RSS %.1f MB)\n",
+                options.connections, options.port, options.serverPid, rssBefore / (1024.0 * 1024.0));
+
+    asio::io_context io;
+    Connector connector(io, options);
+    auto start = Clock::now();
+    connector.Run();
+    double connectSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Give the server time to accept the tail of the backlog
+    std::this_thread::sleep_for(std::chrono::seconds(options.holdSeconds));
+
+    size_t rssAfter = ResidentBytes(options.serverPid);
+    size_t tcpPagesAfter = TcpSocketPages();
+    auto& sockets = connector.Sockets();
+    size_t closed = CountClosedByServer(sockets);
+    size_t held = sockets.size() - closed;
+
+    std::printf("Connected: %zu in %.1fs (failed %zu, closed by server %zu, held %zu)\n",
+                sockets.size(), connectSeconds, connector.Failures(), closed, held);
+    std::printf("Server RSS: %.1f MB -> %.1f MB\n", rssBefore / (1024.0 * 1024.0), rssAfter / (1024.0 * 1024.0));
+    if (held > 0)
+    {
+        double perSession = rssAfter > rssBefore ? static_cast<double>(rssAfter - rssBefore) / held : 0.0;
+        long pageSize = sysconf(_SC_PAGESIZE);
+        double kernelPerSocket = tcpPagesAfter > tcpPagesBefore
+            ? static_cast<double>(tcpPagesAfter - tcpPagesBefore) * pageSize / (2 * held) : 0.0;
+        std::printf("Resident memory per idle session: %.0f bytes (kernel TCP memory per socket: %.0f bytes)\n",
+                    perSession, kernelPerSocket);
+    }
+
+    sockets.clear();
+    return 0;
+}
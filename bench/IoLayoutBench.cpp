@@ -0,0 +1,261 @@
+// Benchmark for the TcpServer I/O layout.
+//
+// Runs a length-prefixed echo server in two layouts and drives it from a separate client
+// io_context over loopback:
+//   shared   - one io_context run by N threads with one acceptor (TcpServer IoMode::Shared)
+//   per-core - N single-threaded io_contexts, each with its own SO_REUSEPORT acceptor
+//              (TcpServer IoMode::PerCore)
+//
+// Reports connection accept rate and echo round-trips per second. Server and client share the
+// machine, so pin them apart (taskset) when comparing thread counts on small hosts.
+//
+// Usage: io_layout_bench [io_threads=4] [connections=512] [seconds=5] [payload=64] [client_threads=4]
+
+#include <boost/asio.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace asio = boost::asio;
+namespace ip = asio::ip;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    struct Options
+    {
+        int ioThreads = 4;
+        size_t connections = 512;
+        int seconds = 5;
+        size_t payload = 64;
+        int clientThreads = 4;
+    };
+
+    struct Result
+    {
+        double acceptsPerSecond = 0.0;
+        double roundTripsPerSecond = 0.0;
+    };
+
+    // Same framing as Session: 4-byte little-endian length followed by the body
+    asio::awaitable<void> EchoSession(ip::tcp::socket socket)
+    {
+        std::vector<char> frame;
+        try
+        {
+            for (;;)
+            {
+                uint32_t length = 0;
+                co_await asio::async_read(socket, asio::buffer(&length, sizeof(length)), asio::use_awaitable);
+                frame.resize(sizeof(length) + length);
+                std::memcpy(frame.data(), &length, sizeof(length));
+                co_await asio::async_read(socket, asio::buffer(frame.data() + sizeof(length), length), asio::use_awaitable);
+                co_await asio::async_write(socket, asio::buffer(frame), asio::use_awaitable);
+            }
+        }
+        catch (const std::exception&)
+        {
+        }
+    }
+
+    asio::awaitable<void> AcceptLoop(ip::tcp::acceptor& acceptor)
+    {
+        try
+        {
+            for (;;)
+            {
+                ip::tcp::socket socket = co_await acceptor.async_accept(asio::use_awaitable);
+                socket.set_option(ip::tcp::no_delay(true));
+                auto executor = socket.get_executor();
+                asio::co_spawn(executor, EchoSession(std::move(socket)), asio::detached);
+            }
+        }
+        catch (const std::exception&)
+        {
+        }
+    }
+
+    void OpenAcceptor(ip::tcp::acceptor& acceptor, unsigned short port, bool reusePort)
+    {
+        ip::tcp::endpoint endpoint(ip::address_v4::loopback(), port);
+        acceptor.open(endpoint.protocol());
+        acceptor.set_option(ip::tcp::acceptor::reuse_address(true));
+        if (reusePort)
+        {
+            acceptor.set_option(asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true));
+        }
+        acceptor.bind(endpoint);
+        acceptor.listen(asio::socket_base::max_listen_connections);
+    }
+
+    class Server
+    {
+    public:
+        Server(int ioThreads, bool perCore)
+        {
+            size_t contextCount = perCore ? ioThreads : 1;
+            for (size_t i = 0; i < contextCount; ++i)
+            {
+                m_contexts.push_back(std::make_unique<asio::io_context>(perCore ? 1 : ioThreads));
+            }
+
+            // First acceptor picks an ephemeral port; per-core acceptors join it with SO_REUSEPORT
+            for (size_t i = 0; i < contextCount; ++i)
+            {
+                auto& acceptor = *m_acceptors.emplace_back(std::make_unique<ip::tcp::acceptor>(*m_contexts[i]));
+                OpenAcceptor(acceptor, m_port, perCore);
+                m_port = acceptor.local_endpoint().port();
+                asio::co_spawn(*m_contexts[i], AcceptLoop(acceptor), asio::detached);
+            }
+
+            for (int i = 0; i < ioThreads; ++i)
+            {
+                auto& context = *m_contexts[perCore ? i : 0];
+                m_threads.emplace_back([&context]() { context.run(); });
+            }
+        }
+
+        ~Server()
+        {
+            for (auto& context : m_contexts)
+            {
+                context->stop();
+            }
+            for (auto& thread : m_threads)
+            {
+                thread.join();
+            }
+            m_acceptors.clear();
+        }
+
+        unsigned short Port() const { return m_port; }
+
+    private:
+        unsigned short m_port = 0;
+        std::vector<std::unique_ptr<asio::io_context>> m_contexts;
+        std::vector<std::unique_ptr<ip::tcp::acceptor>> m_acceptors;
+        std::vector<std::thread> m_threads;
+    };
+
+    asio::awaitable<void> PingPong(ip::tcp::socket& socket, size_t payload, Clock::time_point deadline,
+                                   std::atomic<uint64_t>& roundTrips)
+    {
+        std::vector<char> frame(sizeof(uint32_t) + payload, 'x');
+        uint32_t length = static_cast<uint32_t>(payload);
+        std::memcpy(frame.data(), &length, sizeof(length));
+        std::vector<char> reply(frame.size());
+        uint64_t local = 0;
+        try
+        {
+            while (Clock::now() < deadline)
+            {
+                co_await asio::async_write(socket, asio::buffer(frame), asio::use_awaitable);
+                co_await asio::async_read(socket, asio::buffer(reply), asio::use_awaitable);
+                ++local;
+            }
+        }
+        catch (const std::exception&)
+        {
+        }
+        roundTrips.fetch_add(local, std::memory_order_relaxed);
+    }
+
+    Result Run(const Options& options, bool perCore)
+    {
+        Server server(options.ioThreads, perCore);
+        ip::tcp::endpoint endpoint(ip::address_v4::loopback(), server.Port());
+
+        asio::io_context client(options.clientThreads);
+        std::vector<ip::tcp::socket> sockets;
+        sockets.reserve(options.connections);
+        for (size_t i = 0; i < options.connections; ++i)
+        {
+            sockets.emplace_back(client);
+        }
+
+        auto runClient = [&client, &options]()
+        {
+            client.restart();
+            std::vector<std::thread> threads;
+            for (int i = 0; i < options.clientThreads; ++i)
+            {
+                threads.emplace_back([&client]() { client.run(); });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+        };
+
+        // Phase 1: connect everything at once
+        std::atomic<size_t> connected{0};
+        for (auto& socket : sockets)
+        {
+            socket.async_connect(endpoint, [&socket, &connected](const boost::system::error_code& ec)
+            {
+                if (!ec)
+                {
+                    socket.set_option(ip::tcp::no_delay(true));
+                    connected.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        auto connectStart = Clock::now();
+        runClient();
+        double connectSeconds = std::chrono::duration<double>(Clock::now() - connectStart).count();
+
+        // Phase 2: closed-loop echo on every connection
+        std::atomic<uint64_t> roundTrips{0};
+        auto deadline = Clock::now() + std::chrono::seconds(options.seconds);
+        for (auto& socket : sockets)
+        {
+            if (socket.is_open())
+            {
+                asio::co_spawn(client, PingPong(socket, options.payload, deadline, roundTrips), asio::detached);
+            }
+        }
+        auto echoStart = Clock::now();
+        runClient();
+        double echoSeconds = std::chrono::duration<double>(Clock::now() - echoStart).count();
+
+        for (auto& socket : sockets)
+        {
+            boost::system::error_code ec;
+            socket.close(ec);
+        }
+
+        Result result;
+        result.acceptsPerSecond = connected.load() / connectSeconds;
+        result.roundTripsPerSecond = roundTrips.load() / echoSeconds;
+        return result;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (argc > 1) options.ioThreads = std::atoi(argv[1]);
+    if (argc > 2) options.connections = std::strtoull(argv[2], nullptr, 10);
+    if (argc > 3) options.seconds = std::atoi(argv[3]);
+    if (argc > 4) options.payload = std::strtoull(argv[4], nullptr, 10);
+    if (argc > 5) options.clientThreads = std::atoi(argv[5]);
+
+    std::printf("io_threads=%d connections=%zu seconds=%d payload=%zu client_threads=%d\n",
+                options.ioThreads, options.connections, options.seconds, options.payload, options.clientThreads);
+
+    const struct { const char* name; bool perCore; } layouts[] = { { "shared", false }, { "per-core", true } };
+    for (const auto& layout : layouts)
+    {
+        Result result = Run(options, layout.perCore);
+        std::printf("%-9s accepts/sec %10.0f  round-trips/sec %10.0f\n",
+                    layout.name, result.acceptsPerSecond, result.roundTripsPerSecond);
+    }
+    return 0;
+}
@@ -0,0 +1,220 @@
+// Wait strategy benchmark for JobQueue / GameLogicQueue.
+//
+// Drives a moodycamel::ConcurrentQueue guarded by the server's QueueWaiter with 1..16 producers and
+// a fixed consumer pool (the JobProcessor logic threads), once per strategy:
+//   blocking       - every push takes a mutex and calls notify_one (the queues before this change)
+//   spin-then-park - consumers spin, then park on an eventcount; pushes signal only parked consumers
+//
+// Two phases per producer count:
+//   saturated - producers push `items` as fast as they can; reports pops per second
+//   paced     - each producer pushes one item every `interval_us`, so consumers are mostly idle or
+//               parked; reports push-to-pop wake latency percentiles
+//
+// Usage: queue_wait_bench [consumers=4] [items=2000000] [interval_us=50] [paced_seconds=2] [spin_iterations=2000]
+
+#include <concurrentqueue.h>
+#include "Utils/QueueWaiter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using CppMMO::Utils::QueueWaiter;
+using CppMMO::Utils::WaitConfig;
+using CppMMO::Utils::WaitStrategy;
+
+namespace
+{
+    struct Options
+    {
+        int consumers = 4;
+        size_t items = 2000000;
+        int intervalUs = 50;
+        int pacedSeconds = 2;
+        uint32_t spinIterations = 2000;
+    };
+
+    // Same push/pop shape as JobQueue::PushJob / PopJob
+    struct Queue
+    {
+        explicit Queue(const WaitConfig& config) : waiter(config) {}
+
+        void Push(int64_t item)
+        {
+            queue.enqueue(item);
+            waiter.Notify();
+        }
+
+        bool Pop(int64_t& item)
+        {
+            return waiter.Wait([this, &item] { return queue.try_dequeue(item); }, stop);
+        }
+
+        void Shutdown()
+        {
+            stop.store(true, std::memory_order_release);
+            waiter.NotifyAll();
+        }
+
+        moodycamel::ConcurrentQueue<int64_t> queue{1024};
+        QueueWaiter waiter;
+        std::atomic<bool> stop{false};
+    };
+
+    int64_t NowNanos()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    double Saturated(const Options& options, const WaitConfig& config, int producers)
+    {
+        Queue queue(config);
+        std::atomic<size_t> popped{0};
+        std::vector<std::thread> consumers;
+        for (int i = 0; i < options.consumers; ++i)
+        {
+            consumers.emplace_back([&queue, &popped]()
+            {
+                int64_t item = 0;
+                size_t local = 0;
+                while (queue.Pop(item))
+                {
+                    ++local;
+                }
+                popped.fetch_add(local, std::memory_order_relaxed);
+            });
+        }
+
+        size_t perProducer = options.items / producers;
+        auto start = Clock::now();
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&queue, perProducer]()
+            {
+                for (size_t i = 0; i < perProducer; ++i)
+                {
+                    queue.Push(static_cast<int64_t>(i));
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        // Consumers drain whatever is left before they see the stop flag
+        queue.Shutdown();
+        for (auto& thread : consumers)
+        {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return popped.load() / seconds;
+    }
+
+    struct Latency
+    {
+        double p50Us = 0.0;
+        double p99Us = 0.0;
+        double maxUs = 0.0;
+    };
+
+    Latency Paced(const Options& options, const WaitConfig& config, int producers)
+    {
+        Queue queue(config);
+        std::mutex samplesMutex;
+        std::vector<int64_t> samples;
+        std::vector<std::thread> consumers;
+        for (int i = 0; i < options.consumers; ++i)
+        {
+            consumers.emplace_back([&]()
+            {
+                std::vector<int64_t> local;
+                int64_t pushedAt = 0;
+                while (queue.Pop(pushedAt))
+                {
+                    local.push_back(NowNanos() - pushedAt);
+                }
+                std::lock_guard<std::mutex> lock(samplesMutex);
+                samples.insert(samples.end(), local.begin(), local.end());
+            });
+        }
+
+        auto deadline = Clock::now() + std::chrono::seconds(options.pacedSeconds);
+        auto interval = std::chrono::microseconds(options.intervalUs);
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&queue, deadline, interval, p, producers]()
+            {
+                // Stagger producers across the interval instead of pushing in lockstep
+                auto next = Clock::now() + interval * p / producers;
+                while (next < deadline)
+                {
+                    std::this_thread::sleep_until(next);
+                    queue.Push(NowNanos());
+                    next += interval;
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        queue.Shutdown();
+        for (auto& thread : consumers)
+        {
+            thread.join();
+        }
+
+        Latency latency;
+        if (samples.empty())
+        {
+            return latency;
+        }
+        std::sort(samples.begin(), samples.end());
+        auto at = [&samples](double q) { return samples[std::min(samples.size() - 1, static_cast<size_t>(q * samples.size()))] / 1000.0; };
+        latency.p50Us = at(0.50);
+        latency.p99Us = at(0.99);
+        latency.maxUs = samples.back() / 1000.0;
+        return latency;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (argc > 1) options.consumers = std::max(1, std::atoi(argv[1]));
+    if (argc > 2) options.items = std::strtoull(argv[2], nullptr, 10);
+    if (argc > 3) options.intervalUs = std::max(1, std::atoi(argv[3]));
+    if (argc > 4) options.pacedSeconds = std::max(1, std::atoi(argv[4]));
+    if (argc > 5) options.spinIterations = static_cast<uint32_t>(std::strtoul(argv[5], nullptr, 10));
+
+    std::printf("consumers=%d items=%zu interval_us=%d paced_seconds=%d spin_iterations=%u\n",
+                options.consumers, options.items, options.intervalUs, options.pacedSeconds, options.spinIterations);
+
+    const struct { const char* name; WaitStrategy strategy; } strategies[] = {
+        { "blocking", WaitStrategy::Blocking },
+        { "spin-then-park", WaitStrategy::SpinThenPark },
+    };
+    for (int producers : { 1, 2, 4, 8, 16 })
+    {
+        for (const auto& strategy : strategies)
+        {
+            WaitConfig config;
+            config.strategy = strategy.strategy;
+            config.spin_iterations = options.spinIterations;
+            double opsPerSecond = Saturated(options, config, producers);
+            Latency latency = Paced(options, config, producers);
+            std::printf("producers %2d  %-14s  ops/sec %11.0f  wake latency p50 %7.1fus  p99 %8.1fus  max %9.1fus\n",
+                        producers, strategy.name, opsPerSecond, latency.p50Us, latency.p99Us, latency.maxUs);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,225 @@
+// Microbenchmark for the Session write-loop wakeup.
+//
+// Compares the two ways a producer can wake the per-session writer coroutine:
+//   timer   - every enqueue calls steady_timer::cancel_one() (Session before the parked-flag change;
+//             the timer is never armed, so the writer polls it in a loop)
+//   channel - enqueue signals a concurrent_channel only when the writer has announced it is parked
+//
+// Reports enqueue-to-dequeue latency percentiles, wakeups issued per message, writer loop
+// iterations per message and process CPU time per message.
+//
+// Usage: write_wakeup_bench [messages=200000] [io_threads=2] [interval_us=20] [burst=1]
+
+#include <boost/asio.hpp>
+#include <boost/asio/experimental/concurrent_channel.hpp>
+#include <concurrentqueue.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace asio = boost::asio;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    struct Options
+    {
+        size_t messages = 200000;
+        int ioThreads = 2;
+        int intervalUs = 20;
+        size_t burst = 1;
+    };
+
+    struct Result
+    {
+        std::vector<int64_t> latenciesNs;
+        uint64_t wakeups = 0;
+        uint64_t loopIterations = 0;
+        double cpuSeconds = 0.0;
+        double wallSeconds = 0.0;
+    };
+
+    double CpuSeconds()
+    {
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        auto toSeconds = [](const timeval& tv) { return tv.tv_sec + tv.tv_usec / 1e6; };
+        return toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+    }
+
+    int64_t NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    // Shared state of one run: queue of enqueue timestamps plus the writer's bookkeeping
+    struct Writer
+    {
+        explicit Writer(asio::io_context& io)
+            : timer(io), channel(io.get_executor(), 1), consumerToken(queue) {}
+
+        moodycamel::ConcurrentQueue<int64_t> queue;
+        asio::steady_timer timer;
+        asio::experimental::concurrent_channel<void(boost::system::error_code)> channel;
+        moodycamel::ConsumerToken consumerToken;
+        std::atomic<bool> parked{false};
+        std::atomic<uint64_t> wakeups{0};
+
+        size_t expected = 0;
+        size_t received = 0;
+        uint64_t loopIterations = 0;
+        std::vector<int64_t> latenciesNs;
+
+        bool Drain()
+        {
+            int64_t stamp = 0;
+            bool any = false;
+            while (queue.try_dequeue(consumerToken, stamp))
+            {
+                latenciesNs.push_back(NowNs() - stamp);
+                ++received;
+                any = true;
+            }
+            return any;
+        }
+    };
+
+    asio::awaitable<void> TimerWriteLoop(Writer& writer)
+    {
+        while (writer.received < writer.expected)
+        {
+            ++writer.loopIterations;
+            if (!writer.Drain())
+            {
+                boost::system::error_code ec;
+                co_await writer.timer.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+            }
+        }
+    }
+
+    asio::awaitable<void> ChannelWriteLoop(Writer& writer)
+    {
+        while (writer.received < writer.expected)
+        {
+            ++writer.loopIterations;
+            if (writer.Drain())
+            {
+                continue;
+            }
+
+            writer.parked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (writer.queue.size_approx() > 0)
+            {
+                writer.parked.store(false, std::memory_order_relaxed);
+                continue;
+            }
+            co_await writer.channel.async_receive(asio::as_tuple(asio::use_awaitable));
+        }
+    }
+
+    void TimerWake(Writer& writer)
+    {
+        writer.timer.cancel_one();
+        writer.wakeups.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void ChannelWake(Writer& writer)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (writer.parked.load(std::memory_order_relaxed) &&
+            writer.parked.exchange(false, std::memory_order_acq_rel))
+        {
+            writer.channel.try_send(boost::system::error_code{});
+            writer.wakeups.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename LoopFn, typename WakeFn>
+    Result Run(const Options& options, LoopFn loop, WakeFn wake)
+    {
+        asio::io_context io;
+        Writer writer(io);
+        writer.expected = options.messages;
+        writer.latenciesNs.reserve(options.messages);
+
+        asio::co_spawn(io, loop(writer), [&io](std::exception_ptr) { io.stop(); });
+
+        double cpuStart = CpuSeconds();
+        auto wallStart = Clock::now();
+
+        std::vector<std::thread> ioThreads;
+        for (int i = 0; i < options.ioThreads; ++i)
+        {
+            ioThreads.emplace_back([&io]() { io.run(); });
+        }
+
+        // Paced producer, standing in for the game loop sending to one session
+        moodycamel::ProducerToken producerToken(writer.queue);
+        auto next = Clock::now();
+        for (size_t sent = 0; sent < options.messages;)
+        {
+            for (size_t i = 0; i < options.burst && sent < options.messages; ++i, ++sent)
+            {
+                writer.queue.enqueue(producerToken, NowNs());
+                wake(writer);
+            }
+            next += std::chrono::microseconds(options.intervalUs);
+            std::this_thread::sleep_until(next);
+        }
+
+        for (auto& thread : ioThreads)
+        {
+            thread.join();
+        }
+
+        Result result;
+        result.wallSeconds = std::chrono::duration<double>(Clock::now() - wallStart).count();
+        result.cpuSeconds = CpuSeconds() - cpuStart;
+        result.wakeups = writer.wakeups.load();
+        result.loopIterations = writer.loopIterations;
+        result.latenciesNs = std::move(writer.latenciesNs);
+        return result;
+    }
+
+    void Print(const char* name, Result& result, const Options& options)
+    {
+        auto& lat = result.latenciesNs;
+        std::sort(lat.begin(), lat.end());
+        auto percentile = [&lat](double p) {
+            return lat.empty() ? 0.0 : lat[std::min(lat.size() - 1, static_cast<size_t>(p * lat.size()))] / 1000.0;
+        };
+        double perMessage = static_cast<double>(options.messages);
+        std::printf("%-8s  p50 %8.2f us  p99 %8.2f us  p99.9 %8.2f us  max %9.2f us | "
+                    "wakeups/msg %5.2f  loops/msg %8.2f  cpu/msg %7.2f us  cpu %5.2f s / wall %5.2f s\n",
+                    name, percentile(0.50), percentile(0.99), percentile(0.999), percentile(1.0),
+                    result.wakeups / perMessage, result.loopIterations / perMessage,
+                    result.cpuSeconds * 1e6 / perMessage, result.cpuSeconds, result.wallSeconds);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (argc > 1) options.messages = std::strtoull(argv[1], nullptr, 10);
+    if (argc > 2) options.ioThreads = std::atoi(argv[2]);
+    if (argc > 3) options.intervalUs = std::atoi(argv[3]);
+    if (argc > 4) options.burst = std::strtoull(argv[4], nullptr, 10);
+
+    std::printf("messages=%zu io_threads=%d interval_us=%d burst=%zu\n",
+                options.messages, options.ioThreads, options.intervalUs, options.burst);
+
+    auto timerResult = Run(options, TimerWriteLoop, TimerWake);
+    Print("timer", timerResult, options);
+
+    auto channelResult = Run(options, ChannelWriteLoop, ChannelWake);
+    Print("channel", channelResult, options);
+    return 0;
+}
@@ -0,0 +1,311 @@
+// Send-side CPU cost of MSG_ZEROCOPY versus ordinary copying sends.
+//
+// Models the per-tick SendBatch write: every tick, one batch of `batch_bytes` goes to each of N
+// connections. The sender runs the same schedule twice, once with send() and once with
+// sendmsg(MSG_ZEROCOPY) (draining completion notifications from the error queue, like Session), and
+// reports sender-thread CPU per second and per batch for each.
+//
+// Loopback never sends from user pages (every completion comes back "copied"), so run the sink on a
+// second host to see the real difference:
+//
+//   hostB$ zerocopy_bench sink 9100
+//   hostA$ zerocopy_bench send hostB:9100 600 10 32768 30
+//
+// With no sink address (`send local ...`) an in-process loopback sink is started; use that only to
+// check the plumbing.
+//
+// Usage: zerocopy_bench sink <port>
+//        zerocopy_bench send <host:port|local> [clients=600] [seconds=10] [batch_bytes=32768] [rate_hz=30]
+
+#include <boost/asio.hpp>
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace asio = boost::asio;
+namespace ip = asio::ip;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    struct Options
+    {
+        std::string host = "127.0.0.1";
+        unsigned short port = 0;
+        size_t clients = 600;
+        int seconds = 10;
+        size_t batchBytes = 32768;
+        int rateHz = 30;
+    };
+
+    struct Result
+    {
+        double cpuSeconds = 0.0;
+        double wallSeconds = 0.0;
+        uint64_t batches = 0;
+        uint64_t skipped = 0;       // Send buffer full: the tick's batch is dropped, as a slow consumer would
+        uint64_t completions = 0;
+        uint64_t copied = 0;
+        uint64_t enobufs = 0;
+    };
+
+    double ThreadCpuSeconds()
+    {
+        rusage usage{};
+        getrusage(RUSAGE_THREAD, &usage);
+        auto toSeconds = [](const timeval& tv) { return tv.tv_sec + tv.tv_usec / 1e6; };
+        return toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+    }
+
+    // Accepts connections and discards everything it reads
+    class Sink
+    {
+    public:
+        Sink(asio::io_context& io, unsigned short port)
+            : m_acceptor(io, ip::tcp::endpoint(ip::tcp::v4(), port))
+        {
+            Accept();
+        }
+
+        unsigned short Port() const { return m_acceptor.local_endpoint().port(); }
+
+    private:
+        void Accept()
+        {
+            m_acceptor.async_accept([this](const boost::system::error_code& error, ip::tcp::socket socket)
+            {
+                if (!error)
+                {
+                    auto connection = std::make_shared<ip::tcp::socket>(std::move(socket));
+                    Drain(connection, std::make_shared<std::vector<char>>(256 * 1024));
+                }
+                Accept();
+            });
+        }
+
+        static void Drain(std::shared_ptr<ip::tcp::socket> socket, std::shared_ptr<std::vector<char>> buffer)
+        {
+            socket->async_read_some(asio::buffer(*buffer), [socket, buffer](const boost::system::error_code& error, size_t)
+            {
+                if (!error)
+                {
+                    Drain(socket, buffer);
+                }
+            });
+        }
+
+        ip::tcp::acceptor m_acceptor;
+    };
+
+    std::vector<int> Connect(const Options& options)
+    {
+        std::vector<int> sockets;
+        asio::io_context io;
+        ip::tcp::resolver resolver(io);
+        auto endpoint = *resolver.resolve(options.host, std::to_string(options.port)).begin();
+        for (size_t i = 0; i < options.clients; ++i)
+        {
+            ip::tcp::socket socket(io);
+            socket.connect(endpoint.endpoint());
+            socket.set_option(ip::tcp::no_delay(true));
+            int enable = 1;
+            if (setsockopt(socket.native_handle(), SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) != 0)
+            {
+                std::fprintf(stderr, "SO_ZEROCOPY not supported: %s\n", std::strerror(errno));
+                std::exit(1);
+            }
+            sockets.push_back(socket.release());
+        }
+        return sockets;
+    }
+
+    void ReapCompletions(int fd, Result& result)
+    {
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+        while (true)
+        {
+            msghdr message{};
+            message.msg_control = control;
+            message.msg_controllen = sizeof(control);
+            if (recvmsg(fd, &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+            {
+                return;
+            }
+            for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header))
+            {
+                sock_extended_err notification;
+                std::memcpy(&notification, CMSG_DATA(header), sizeof(notification));
+                if (notification.ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+                {
+                    continue;
+                }
+                uint64_t count = notification.ee_data - notification.ee_info + 1;
+                result.completions += count;
+                if (notification.ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+                {
+                    result.copied += count;
+                }
+            }
+        }
+    }
+
+    Result Run(const std::vector<int>& sockets, const Options& options, bool zeroCopy)
+    {
+        // One payload per connection, never modified while the kernel may still be reading it
+        std::vector<std::vector<char>> payloads(sockets.size(), std::vector<char>(options.batchBytes, 'x'));
+
+        Result result;
+        auto interval = std::chrono::nanoseconds(1000000000LL / options.rateHz);
+        auto start = Clock::now();
+        auto end = start + std::chrono::seconds(options.seconds);
+        double cpuStart = ThreadCpuSeconds();
+
+        for (auto tick = start; tick < end; tick += interval)
+        {
+            for (size_t i = 0; i < sockets.size(); ++i)
+            {
+                int fd = sockets[i];
+                if (zeroCopy)
+                {
+                    ReapCompletions(fd, result);
+                }
+
+                iovec iov{payloads[i].data(), payloads[i].size()};
+                msghdr message{};
+                message.msg_iov = &iov;
+                message.msg_iovlen = 1;
+                int flags = MSG_DONTWAIT | MSG_NOSIGNAL | (zeroCopy ? MSG_ZEROCOPY : 0);
+                ssize_t sent = sendmsg(fd, &message, flags);
+                if (sent < 0 && errno == ENOBUFS)
+                {
+                    ++result.enobufs;
+                    sent = sendmsg(fd, &message, MSG_DONTWAIT | MSG_NOSIGNAL);
+                }
+                if (sent < 0)
+                {
+                    ++result.skipped;
+                    continue;
+                }
+                ++result.batches;
+            }
+            std::this_thread::sleep_until(tick + interval);
+        }
+
+        if (zeroCopy)
+        {
+            // Let the last notifications arrive so completion counts are comparable
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            for (int fd : sockets)
+            {
+                ReapCompletions(fd, result);
+            }
+        }
+
+        result.cpuSeconds = ThreadCpuSeconds() - cpuStart;
+        result.wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return result;
+    }
+
+    void Print(const char* name, const Result& result)
+    {
+        double usPerBatch = result.batches > 0 ? result.cpuSeconds * 1e6 / result.batches : 0.0;
+        std::printf("%-9s CPU: %6.1f ms/s  %6.2f us/batch  batches: %llu  skipped: %llu",
+                    name, result.cpuSeconds * 1000.0 / result.wallSeconds, usPerBatch,
+                    static_cast<unsigned long long>(result.batches), static_cast<unsigned long long>(result.skipped));
+        if (result.completions > 0 || result.enobufs > 0)
+        {
+            std::printf("  completions: %llu (copied %llu)  ENOBUFS: %llu",
+                        static_cast<unsigned long long>(result.completions), static_cast<unsigned long long>(result.copied),
+                        static_cast<unsigned long long>(result.enobufs));
+        }
+        std::printf("\n");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc >= 3 && std::string(argv[1]) == "sink")
+    {
+        asio::io_context io;
+        Sink sink(io, static_cast<unsigned short>(std::atoi(argv[2])));
+        std::printf("Sink listening on port %u\n", sink.Port());
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 2; ++i)
+        {
+            threads.emplace_back([&io]() { io.run(); });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        return 0;
+    }
+
+    if (argc < 3 || std::string(argv[1]) != "send")
+    {
+        std::fprintf(stderr, "usage: %s sink <port>\n       %s send <host:port|local> [clients] [seconds] [batch_bytes] [rate_hz]\n",
+                     argv[0], argv[0]);
+        return 1;
+    }
+
+    Options options;
+    std::string target = argv[2];
+    if (argc > 3) options.clients = std::strtoull(argv[3], nullptr, 10);
+    if (argc > 4) options.seconds = std::atoi(argv[4]);
+    if (argc > 5) options.batchBytes = std::strtoull(argv[5], nullptr, 10);
+    if (argc > 6) options.rateHz = std::max(1, std::atoi(argv[6]));
+
+    // In-process loopback sink for `local`
+    asio::io_context sinkIo;
+    std::unique_ptr<Sink> localSink;
+    std::thread sinkThread;
+    if (target == "local")
+    {
+        localSink = std::make_unique<Sink>(sinkIo, 0);
+        options.port = localSink->Port();
+        sinkThread = std::thread([&sinkIo]() { sinkIo.run(); });
+    }
+    else
+    {
+        auto colon = target.rfind(':');
+        if (colon == std::string::npos)
+        {
+            std::fprintf(stderr, "sink address must be host:port\n");
+            return 1;
+        }
+        options.host = target.substr(0, colon);
+        options.port = static_cast<unsigned short>(std::atoi(target.c_str() + colon + 1));
+    }
+
+    auto sockets = Connect(options);
+    std::printf("%zu connections to %s:%u, %zu-byte batch at %d Hz for %ds per mode\n",
+                sockets.size(), options.host.c_str(), options.port, options.batchBytes, options.rateHz, options.seconds);
+
+    Print("copy", Run(sockets, options, false));
+    Print("zerocopy", Run(sockets, options, true));
+
+    for (int fd : sockets)
+    {
+        close(fd);
+    }
+    if (localSink)
+    {
+        sinkIo.stop();
+        sinkThread.join();
+    }
+    return 0;
+}
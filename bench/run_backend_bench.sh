@@ -0,0 +1,21 @@
+#!/bin/bash
+# Side-by-side epoll / io_uring run at 1k and 5k simulated clients.
+# Usage: bench/run_backend_bench.sh <build dir> [seconds=10] [rate_hz=30]
+# 5k clients need ~10k descriptors (client + server side of every connection).
+set -e
+BUILD_DIR=${1:?build dir}
+SECONDS_PER_RUN=${2:-10}
+RATE_HZ=${3:-30}
+
+ulimit -n 65536 2>/dev/null || echo "warning: could not raise open file limit ($(ulimit -n))"
+
+for CLIENTS in 1000 5000; do
+    for BACKEND in epoll uring; do
+        BIN="$BUILD_DIR/bench/backend_bench_$BACKEND"
+        if [ -x "$BIN" ]; then
+            "$BIN" "$CLIENTS" "$SECONDS_PER_RUN" "$RATE_HZ"
+        else
+            echo "skipping $BACKEND: $BIN not built"
+        fi
+    done
+done
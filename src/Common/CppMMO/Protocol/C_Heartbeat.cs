@@ -0,0 +1,50 @@
+// <auto-generated>
+//  automatically generated by the FlatBuffers compiler, do not modify
+// </auto-generated>
+
+namespace CppMMO.Protocol
+{
+
+using global::System;
+using global::System.Collections.Generic;
+using global::Google.FlatBuffers;
+
+public struct C_Heartbeat : IFlatbufferObject
+{
+  private Table __p;
+  public ByteBuffer ByteBuffer { get { return __p.bb; } }
+  public static void ValidateVersion() { FlatBufferConstants.FLATBUFFERS_25_2_10(); }
+  public static C_Heartbeat GetRootAsC_Heartbeat(ByteBuffer _bb) { return GetRootAsC_Heartbeat(_bb, new C_Heartbeat()); }
+  public static C_Heartbeat GetRootAsC_Heartbeat(ByteBuffer _bb, C_Heartbeat obj) { return (obj.__assign(_bb.GetInt(_bb.Position) + _bb.Position, _bb)); }
+  public void __init(int _i, ByteBuffer _bb) { __p = new Table(_i, _bb); }
+  public C_Heartbeat __assign(int _i, ByteBuffer _bb) { __init(_i, _bb); return this; }
+
+  public ulong ClientTime { get { int o = __p.__offset(4); return o != 0 ? __p.bb.GetUlong(o + __p.bb_pos) : (ulong)0; } }
+
+  public static Offset<CppMMO.Protocol.C_Heartbeat> CreateC_Heartbeat(FlatBufferBuilder builder,
+      ulong client_time = 0) {
+    builder.StartTable(1);
+    C_Heartbeat.AddClientTime(builder, client_time);
+    return C_Heartbeat.EndC_Heartbeat(builder);
+  }
+
+  public static void StartC_Heartbeat(FlatBufferBuilder builder) { builder.StartTable(1); }
+  public static void AddClientTime(FlatBufferBuilder builder, ulong clientTime) { builder.AddUlong(0, clientTime, 0); }
+  public static Offset<CppMMO.Protocol.C_Heartbeat> EndC_Heartbeat(FlatBufferBuilder builder) {
+    int o = builder.EndTable();
+    return new Offset<CppMMO.Protocol.C_Heartbeat>(o);
+  }
+}
+
+
+static public class C_HeartbeatVerify
+{
+  static public bool Verify(Google.FlatBuffers.Verifier verifier, uint tablePos)
+  {
+    return verifier.VerifyTableStart(tablePos)
+      && verifier.VerifyField(tablePos, 4 /*ClientTime*/, 8 /*ulong*/, 8, false)
+      && verifier.VerifyTableEnd(tablePos);
+  }
+}
+
+}
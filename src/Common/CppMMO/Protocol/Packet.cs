@@ -21,6 +21,8 @@ public enum Packet : byte
   S_ZoneEntered = 11,
   S_PlayerJoined = 12,
   S_PlayerLeft = 13,
+  C_Heartbeat = 14,
+  S_Heartbeat = 15,
 };
 
 
@@ -71,6 +73,12 @@ static public class PacketVerify
       case Packet.S_PlayerLeft:
         result = CppMMO.Protocol.S_PlayerLeftVerify.Verify(verifier, tablePos);
         break;
+      case Packet.C_Heartbeat:
+        result = CppMMO.Protocol.C_HeartbeatVerify.Verify(verifier, tablePos);
+        break;
+      case Packet.S_Heartbeat:
+        result = CppMMO.Protocol.S_HeartbeatVerify.Verify(verifier, tablePos);
+        break;
       default: result = true;
         break;
     }
@@ -21,6 +21,8 @@ public enum PacketId : ushort
   S_ZoneEntered = 21,
   S_PlayerJoined = 22,
   S_PlayerLeft = 23,
+  C_Heartbeat = 30,
+  S_Heartbeat = 31,
 };
 
 
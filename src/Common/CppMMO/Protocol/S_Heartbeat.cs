@@ -0,0 +1,55 @@
+// <auto-generated>
+//  automatically generated by the FlatBuffers compiler, do not modify
+// </auto-generated>
+
+namespace CppMMO.Protocol
+{
+
+using global::System;
+using global::System.Collections.Generic;
+using global::Google.FlatBuffers;
+
+public struct S_Heartbeat : IFlatbufferObject
+{
+  private Table __p;
+  public ByteBuffer ByteBuffer { get { return __p.bb; } }
+  public static void ValidateVersion() { FlatBufferConstants.FLATBUFFERS_25_2_10(); }
+  public static S_Heartbeat GetRootAsS_Heartbeat(ByteBuffer _bb) { return GetRootAsS_Heartbeat(_bb, new S_Heartbeat()); }
+  public static S_Heartbeat GetRootAsS_Heartbeat(ByteBuffer _bb, S_Heartbeat obj) { return (obj.__assign(_bb.GetInt(_bb.Position) + _bb.Position, _bb)); }
+  public void __init(int _i, ByteBuffer _bb) { __p = new Table(_i, _bb); }
+  public S_Heartbeat __assign(int _i, ByteBuffer _bb) { __init(_i, _bb); return this; }
+
+  public ulong ClientTime { get { int o = __p.__offset(4); return o != 0 ? __p.bb.GetUlong(o + __p.bb_pos) : (ulong)0; } }
+  public ulong ServerTime { get { int o = __p.__offset(6); return o != 0 ? __p.bb.GetUlong(o + __p.bb_pos) : (ulong)0; } }
+
+  public static Offset<CppMMO.Protocol.S_Heartbeat> CreateS_Heartbeat(FlatBufferBuilder builder,
+      ulong client_time = 0,
+      ulong server_time = 0) {
+    builder.StartTable(2);
+    S_Heartbeat.AddServerTime(builder, server_time);
+    S_Heartbeat.AddClientTime(builder, client_time);
+    return S_Heartbeat.EndS_Heartbeat(builder);
+  }
+
+  public static void StartS_Heartbeat(FlatBufferBuilder builder) { builder.StartTable(2); }
+  public static void AddClientTime(FlatBufferBuilder builder, ulong clientTime) { builder.AddUlong(0, clientTime, 0); }
+  public static void AddServerTime(FlatBufferBuilder builder, ulong serverTime) { builder.AddUlong(1, serverTime, 0); }
+  public static Offset<CppMMO.Protocol.S_Heartbeat> EndS_Heartbeat(FlatBufferBuilder builder) {
+    int o = builder.EndTable();
+    return new Offset<CppMMO.Protocol.S_Heartbeat>(o);
+  }
+}
+
+
+static public class S_HeartbeatVerify
+{
+  static public bool Verify(Google.FlatBuffers.Verifier verifier, uint tablePos)
+  {
+    return verifier.VerifyTableStart(tablePos)
+      && verifier.VerifyField(tablePos, 4 /*ClientTime*/, 8 /*ulong*/, 8, false)
+      && verifier.VerifyField(tablePos, 6 /*ServerTime*/, 8 /*ulong*/, 8, false)
+      && verifier.VerifyTableEnd(tablePos);
+  }
+}
+
+}
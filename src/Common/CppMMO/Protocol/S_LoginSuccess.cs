@@ -21,19 +21,31 @@ public struct S_LoginSuccess : IFlatbufferObject
 
   public CppMMO.Protocol.PlayerInfo? PlayerInfo { get { int o = __p.__offset(4); return o != 0 ? (CppMMO.Protocol.PlayerInfo?)(new CppMMO.Protocol.PlayerInfo()).__assign(__p.__indirect(o + __p.bb_pos), __p.bb) : null; } }
   public long CommandId { get { int o = __p.__offset(6); return o != 0 ? __p.bb.GetLong(o + __p.bb_pos) : (long)0; } }
+  public ulong UdpToken { get { int o = __p.__offset(8); return o != 0 ? __p.bb.GetUlong(o + __p.bb_pos) : (ulong)0; } }
+  public ushort UdpPort { get { int o = __p.__offset(10); return o != 0 ? __p.bb.GetUshort(o + __p.bb_pos) : (ushort)0; } }
+  public bool Lz4Enabled { get { int o = __p.__offset(12); return o != 0 ? 0!=__p.bb.Get(o + __p.bb_pos) : (bool)false; } }
 
   public static Offset<CppMMO.Protocol.S_LoginSuccess> CreateS_LoginSuccess(FlatBufferBuilder builder,
       Offset<CppMMO.Protocol.PlayerInfo> player_infoOffset = default(Offset<CppMMO.Protocol.PlayerInfo>),
-      long command_id = 0) {
-    builder.StartTable(2);
+      long command_id = 0,
+      ulong udp_token = 0,
+      ushort udp_port = 0,
+      bool lz4_enabled = false) {
+    builder.StartTable(5);
+    S_LoginSuccess.AddUdpToken(builder, udp_token);
     S_LoginSuccess.AddCommandId(builder, command_id);
     S_LoginSuccess.AddPlayerInfo(builder, player_infoOffset);
+    S_LoginSuccess.AddUdpPort(builder, udp_port);
+    S_LoginSuccess.AddLz4Enabled(builder, lz4_enabled);
     return S_LoginSuccess.EndS_LoginSuccess(builder);
   }
 
-  public static void StartS_LoginSuccess(FlatBufferBuilder builder) { builder.StartTable(2); }
+  public static void StartS_LoginSuccess(FlatBufferBuilder builder) { builder.StartTable(5); }
   public static void AddPlayerInfo(FlatBufferBuilder builder, Offset<CppMMO.Protocol.PlayerInfo> playerInfoOffset) { builder.AddOffset(0, playerInfoOffset.Value, 0); }
   public static void AddCommandId(FlatBufferBuilder builder, long commandId) { builder.AddLong(1, commandId, 0); }
+  public static void AddUdpToken(FlatBufferBuilder builder, ulong udpToken) { builder.AddUlong(2, udpToken, 0); }
+  public static void AddUdpPort(FlatBufferBuilder builder, ushort udpPort) { builder.AddUshort(3, udpPort, 0); }
+  public static void AddLz4Enabled(FlatBufferBuilder builder, bool lz4Enabled) { builder.AddBool(4, lz4Enabled, false); }
   public static Offset<CppMMO.Protocol.S_LoginSuccess> EndS_LoginSuccess(FlatBufferBuilder builder) {
     int o = builder.EndTable();
     return new Offset<CppMMO.Protocol.S_LoginSuccess>(o);
@@ -48,6 +60,9 @@ static public class S_LoginSuccessVerify
     return verifier.VerifyTableStart(tablePos)
       && verifier.VerifyTable(tablePos, 4 /*PlayerInfo*/, CppMMO.Protocol.PlayerInfoVerify.Verify, false)
       && verifier.VerifyField(tablePos, 6 /*CommandId*/, 8 /*long*/, 8, false)
+      && verifier.VerifyField(tablePos, 8 /*UdpToken*/, 8 /*ulong*/, 8, false)
+      && verifier.VerifyField(tablePos, 10 /*UdpPort*/, 2 /*ushort*/, 2, false)
+      && verifier.VerifyField(tablePos, 12 /*Lz4Enabled*/, 1 /*bool*/, 1, false)
       && verifier.VerifyTableEnd(tablePos);
   }
 }
@@ -36,6 +36,8 @@ public struct UnifiedPacket : IFlatbufferObject
   public CppMMO.Protocol.S_ZoneEntered DataAsS_ZoneEntered() { return Data<CppMMO.Protocol.S_ZoneEntered>().Value; }
   public CppMMO.Protocol.S_PlayerJoined DataAsS_PlayerJoined() { return Data<CppMMO.Protocol.S_PlayerJoined>().Value; }
   public CppMMO.Protocol.S_PlayerLeft DataAsS_PlayerLeft() { return Data<CppMMO.Protocol.S_PlayerLeft>().Value; }
+  public CppMMO.Protocol.C_Heartbeat DataAsC_Heartbeat() { return Data<CppMMO.Protocol.C_Heartbeat>().Value; }
+  public CppMMO.Protocol.S_Heartbeat DataAsS_Heartbeat() { return Data<CppMMO.Protocol.S_Heartbeat>().Value; }
 
   public static Offset<CppMMO.Protocol.UnifiedPacket> CreateUnifiedPacket(FlatBufferBuilder builder,
       CppMMO.Protocol.PacketId id = CppMMO.Protocol.PacketId.NONE,
@@ -0,0 +1,37 @@
+#pragma once
+// Standard headers only, so the benches can include it without the server's pch
+#include <cstdint>
+#include <type_traits>
+
+namespace CppMMO
+{
+    namespace Game
+    {
+        enum class CompactCommandType : uint8_t
+        {
+            PlayerInput,
+            EnterZone,
+            PlayerDisconnect
+        };
+
+        /**
+         * @brief Fixed-size record for the per-tick hot commands (input, enter zone, disconnect).
+         *
+         * Trivially copyable so it can travel through GameLogicQueue's per-producer SPSC rings by
+         * plain copy, instead of a GameCommand whose variant also carries strings and vectors.
+         */
+        struct CompactGameCommand
+        {
+            int64_t receivedAtUs = 0;       // GetSteadyMicros() when the I/O thread read the packet; 0 = not from a packet
+            int64_t sessionId = 0;
+            uint64_t playerId = 0;
+            uint32_t sequenceNumber = 0;    // PlayerInput
+            int32_t zoneId = 0;             // EnterZone
+            CompactCommandType type = CompactCommandType::PlayerInput;
+            uint8_t inputFlags = 0;         // PlayerInput
+        };
+
+        static_assert(std::is_trivially_copyable_v<CompactGameCommand>);
+        static_assert(sizeof(CompactGameCommand) <= 40);
+    }
+}
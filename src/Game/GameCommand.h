@@ -79,6 +79,12 @@
                 std::chrono::steady_clock::now().time_since_epoch()).count();
         }
 
+        inline int64_t GetSteadyMicros()
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
         struct PlayerInputCommandData
         {
             uint64_t playerId = 0;
@@ -113,11 +119,33 @@
             uint64_t playerId = 0;
         };
 
+        struct RestoredPlayerState
+        {
+            uint64_t playerId = 0;
+            std::string name;
+            Vec3 position{};
+            Vec3 velocity{};
+            float rotation = 0.0f;
+            int hp = 100;
+            int mp = 50;
+            uint8_t inputFlags = 0;
+            uint32_t lastInputSequence = 0;
+            uint64_t sessionId = 0;     // Session in this process; 0 = player was not connected
+        };
+
+        // World handed over from the previous server process (zero-downtime restart)
+        struct WorldRestoreCommandData
+        {
+            uint64_t tickNumber = 0;
+            std::vector<RestoredPlayerState> players;
+        };
+
         using GameCommandPayload = std::variant<
             PlayerInputCommandData,
             EnterZoneCommandData,
             PlayerSpawnCommandData,
-            PlayerDisconnectCommandData
+            PlayerDisconnectCommandData,
+            WorldRestoreCommandData
         >;
 
         struct GameCommand
@@ -126,6 +154,7 @@
             GameCommandPayload payload{};
             int64_t senderSessionId = 0;
             uint64_t timestamp = 0;
+            int64_t receivedAtUs = 0;   // GetSteadyMicros() when the I/O thread read the packet; 0 = not from a packet
         };
     }
 }
\ No newline at end of file
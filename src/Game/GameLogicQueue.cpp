@@ -4,8 +4,159 @@ namespace CppMMO
 {
     namespace Game
     {
-        GameLogicQueue::GameLogicQueue()
+        namespace
         {
+            std::atomic<uint64_t> s_nextInstanceId{1};
+
+            // Per-thread cache of the token this thread pushes with. Keyed by instance ID rather than
+            // address so a queue allocated where a destroyed one lived never reuses its stale token.
+            struct CachedProducerToken
+            {
+                uint64_t queueId = 0;
+                moodycamel::ProducerToken* token = nullptr;
+            };
+            thread_local CachedProducerToken t_producerToken;
+
+            struct CachedCompactLane
+            {
+                uint64_t queueId = 0;
+                void* lane = nullptr;   // GameLogicQueue::CompactLane, private to the queue
+            };
+            thread_local CachedCompactLane t_compactLane;
+
+            GameCommand ExpandCompactCommand(const CompactGameCommand& compact)
+            {
+                GameCommand command;
+                command.senderSessionId = compact.sessionId;
+                command.receivedAtUs = compact.receivedAtUs;
+                switch (compact.type)
+                {
+                    case CompactCommandType::PlayerInput:
+                    {
+                        PlayerInputCommandData data;
+                        data.playerId = compact.playerId;
+                        data.inputFlags = compact.inputFlags;
+                        data.sequenceNumber = compact.sequenceNumber;
+                        data.sessionId = compact.sessionId;
+                        command.payload = data;
+                        break;
+                    }
+                    case CompactCommandType::EnterZone:
+                        command.payload = EnterZoneCommandData{compact.playerId, compact.zoneId, compact.sessionId};
+                        break;
+                    case CompactCommandType::PlayerDisconnect:
+                        command.payload = PlayerDisconnectCommandData{compact.playerId};
+                        break;
+                }
+                return command;
+            }
+        }
+
+        GameLogicQueue::GameLogicQueue(const Utils::WaitConfig& waitConfig)
+            : m_instanceId(s_nextInstanceId.fetch_add(1, std::memory_order_relaxed)), m_waiter(waitConfig)
+        {
+        }
+
+        moodycamel::ProducerToken& GameLogicQueue::GetProducerToken()
+        {
+            if (t_producerToken.queueId != m_instanceId)
+            {
+                // One token per producing thread (I/O threads, packet workers, the game thread) for the
+                // queue's lifetime; the queue owns it, the thread only keeps a pointer
+                std::lock_guard<std::mutex> lock(m_producersMutex);
+                m_producerTokens.emplace_back(m_gameCommandQueue);
+                t_producerToken.queueId = m_instanceId;
+                t_producerToken.token = &m_producerTokens.back();
+            }
+            return *t_producerToken.token;
+        }
+
+        GameLogicQueue::CompactLane* GameLogicQueue::GetCompactLane()
+        {
+            if (t_compactLane.queueId != m_instanceId)
+            {
+                std::lock_guard<std::mutex> lock(m_producersMutex);
+                size_t index = m_compactLaneCount.load(std::memory_order_relaxed);
+                CompactLane* lane = nullptr;
+                if (index < MAX_COMPACT_PRODUCERS)
+                {
+                    m_compactLanes[index] = std::make_unique<CompactLane>();
+                    lane = m_compactLanes[index].get();
+                    m_compactLaneCount.store(index + 1, std::memory_order_release);
+                }
+                else
+                {
+                    LOG_WARN("GameLogicQueue: more than {} producer threads, extra ones use the MPMC lane.", MAX_COMPACT_PRODUCERS);
+                }
+                t_compactLane.queueId = m_instanceId;
+                t_compactLane.lane = lane;
+            }
+            return static_cast<CompactLane*>(t_compactLane.lane);
+        }
+
+        void GameLogicQueue::PushCompactCommand(const CompactGameCommand& command)
+        {
+            if (m_shuttingDown.load(std::memory_order_acquire))
+            {
+                LOG_WARN("Attempted to push game command to a shutting down queue.");
+                return;
+            }
+            CompactLane* lane = GetCompactLane();
+            if (!lane)
+            {
+                // Every command from this thread takes the MPMC lane, so its order still holds
+                m_compactOverflows.fetch_add(1, std::memory_order_relaxed);
+                m_gameCommandQueue.enqueue(GetProducerToken(), ExpandCompactCommand(command));
+                m_waiter.Notify();
+                return;
+            }
+            if (!lane->spilling.load(std::memory_order_acquire) && lane->ring.TryPush(command))
+            {
+                return;
+            }
+            // The game thread is far behind; keep the command rather than block an I/O thread, and keep
+            // it behind the ring's records so HandlePlayerInput's sequence check does not drop them
+            m_compactOverflows.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(lane->spillMutex);
+            lane->spill.push_back(command);
+            lane->spilling.store(true, std::memory_order_release);
+        }
+
+        size_t GameLogicQueue::TryPopCompactCommands(CompactGameCommand* out, size_t max)
+        {
+            size_t lanes = m_compactLaneCount.load(std::memory_order_acquire);
+            if (lanes == 0)
+            {
+                return 0;
+            }
+            // An equal share per lane, starting one lane later each call, so a flooding producer
+            // cannot starve the others out of the tick's budget
+            size_t share = std::max<size_t>(1, max / lanes);
+            size_t count = 0;
+            for (size_t i = 0; i < lanes && count < max; ++i)
+            {
+                CompactLane& lane = *m_compactLanes[(m_compactSweepStart + i) % lanes];
+                size_t want = std::min(share, max - count);
+                // Read before the ring: once set, the producer has stopped pushing to the ring, so a
+                // short pop below means the ring is empty and the spill holds the next records
+                bool spilling = lane.spilling.load(std::memory_order_acquire);
+                size_t popped = lane.ring.TryPopBulk(out + count, want);
+                count += popped;
+                if (spilling && popped < want)
+                {
+                    std::lock_guard<std::mutex> lock(lane.spillMutex);
+                    size_t take = std::min(want - popped, lane.spill.size());
+                    std::copy_n(lane.spill.begin(), take, out + count);
+                    lane.spill.erase(lane.spill.begin(), lane.spill.begin() + take);
+                    count += take;
+                    if (lane.spill.empty())
+                    {
+                        lane.spilling.store(false, std::memory_order_release);
+                    }
+                }
+            }
+            m_compactSweepStart = (m_compactSweepStart + 1) % lanes;
+            return count;
         }
 
         void GameLogicQueue::PushGameCommand(GameCommand gameCommand)
@@ -15,20 +166,14 @@ namespace CppMMO
                 LOG_WARN("Attempted to push game command to a shutting down queue.");
                 return;
             }
-            m_gameCommandQueue.enqueue(std::move(gameCommand));
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_condition.notify_one();
+            m_gameCommandQueue.enqueue(GetProducerToken(), std::move(gameCommand));
+            m_waiter.Notify();
         }
 
         GameCommand GameLogicQueue::PopGameCommand()
         {
             GameCommand command;
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_condition.wait(lock, [this, &command]
-            {
-                return m_gameCommandQueue.try_dequeue(command) || m_shuttingDown.load(std::memory_order_acquire);
-            });
-            if(m_shuttingDown.load(std::memory_order_acquire) && !m_gameCommandQueue.try_dequeue(command))
+            if (!m_waiter.Wait([this, &command] { return m_gameCommandQueue.try_dequeue(command); }, m_shuttingDown))
             {
                 return GameCommand{};
             }
@@ -45,11 +190,32 @@ namespace CppMMO
             return std::nullopt;
         }
 
+        size_t GameLogicQueue::TryPopGameCommands(GameCommand* out, size_t max)
+        {
+            return m_gameCommandQueue.try_dequeue_bulk(m_consumerToken, out, max);
+        }
+
+        size_t GameLogicQueue::GetApproxSize() const
+        {
+            size_t size = m_gameCommandQueue.size_approx();
+            size_t lanes = m_compactLaneCount.load(std::memory_order_acquire);
+            for (size_t i = 0; i < lanes; ++i)
+            {
+                CompactLane& lane = *m_compactLanes[i];
+                size += lane.ring.SizeApprox();
+                if (lane.spilling.load(std::memory_order_acquire))
+                {
+                    std::lock_guard<std::mutex> lock(lane.spillMutex);
+                    size += lane.spill.size();
+                }
+            }
+            return size;
+        }
+
         void GameLogicQueue::Shutdown()
         {
             m_shuttingDown.store(true, std::memory_order_release);
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_condition.notify_all();
+            m_waiter.NotifyAll();
         }
     }
-}
\ No newline at end of file
+}
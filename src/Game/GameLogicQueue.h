@@ -1,25 +1,77 @@
 #pragma once
 #include "pch.h"
 #include "GameCommand.h"
+#include "CompactGameCommand.h"
+#include "Utils/QueueWaiter.h"
+#include "Utils/SpscRing.h"
 
 namespace CppMMO
 {
     namespace Game
     {
+        /**
+         * @brief Commands from the network side to the game thread.
+         *
+         * Two lanes: a moodycamel MPMC queue for full GameCommands (world restore), and one SPSC ring
+         * of CompactGameCommand per producing thread for the hot commands (input, zone entry,
+         * disconnect). When a ring is full its records spill into a per-producer overflow list that
+         * the game thread drains after the ring, so a producer's commands always arrive in push order.
+         * Threads past MAX_COMPACT_PRODUCERS have no ring and send everything through the MPMC lane.
+         * The game thread drains both with TryPopGameCommands / TryPopCompactCommands; PopGameCommand
+         * only sees the MPMC lane.
+         */
         class GameLogicQueue
         {
         public:
-            GameLogicQueue();
+            static constexpr size_t COMPACT_RING_CAPACITY = 4096;   // Records per producer thread
+            static constexpr size_t MAX_COMPACT_PRODUCERS = 64;     // Threads past this use the MPMC lane
+
+            explicit GameLogicQueue(const Utils::WaitConfig& waitConfig = {});
+            // Enqueues through the calling thread's ProducerToken (created on its first push)
             void PushGameCommand(GameCommand gameCommand);
             GameCommand PopGameCommand();
             std::optional<GameCommand> TryPopGameCommand();
+            // Game thread only: moves up to `max` commands into `out` (move-assigned), returns the count
+            size_t TryPopGameCommands(GameCommand* out, size_t max);
+            // Copies the command into the calling thread's ring, or its spill list while the ring is full
+            void PushCompactCommand(const CompactGameCommand& command);
+            // Game thread only: one round-robin sweep over the producer lanes, up to `max` records into `out`
+            size_t TryPopCompactCommands(CompactGameCommand* out, size_t max);
+            // Compact commands that missed their ring: spilled because it was full, or no ring was left
+            uint64_t GetCompactOverflowCount() const { return m_compactOverflows.load(std::memory_order_relaxed); }
+            // Both lanes
+            size_t GetApproxSize() const;
             void Shutdown();
             bool IsShuttingDown() const {return m_shuttingDown.load(std::memory_order_acquire);}
         private:
+            using CompactRing = Utils::SpscRing<CompactGameCommand, COMPACT_RING_CAPACITY>;
+
+            struct CompactLane
+            {
+                CompactRing ring;
+                // Set by the producer when the ring is full; from then on it appends to `spill` instead
+                // of the ring, and only the game thread clears it, once ring and spill are both empty
+                std::atomic<bool> spilling{false};
+                std::mutex spillMutex;
+                std::deque<CompactGameCommand> spill;
+            };
+
+            moodycamel::ProducerToken& GetProducerToken();
+            CompactLane* GetCompactLane();
+
             moodycamel::ConcurrentQueue<GameCommand> m_gameCommandQueue{};
-            mutable std::mutex m_mutex{};
-            std::condition_variable m_condition{};
+            // Declared after the queue so they are destroyed before it
+            std::mutex m_producersMutex;
+            std::deque<moodycamel::ProducerToken> m_producerTokens;
+            moodycamel::ConsumerToken m_consumerToken{m_gameCommandQueue};
+            // Slots [0, m_compactRingCount) are filled before the count is published
+            std::array<std::unique_ptr<CompactLane>, MAX_COMPACT_PRODUCERS> m_compactLanes{};
+            std::atomic<size_t> m_compactLaneCount{0};
+            size_t m_compactSweepStart = 0;
+            std::atomic<uint64_t> m_compactOverflows{0};
+            const uint64_t m_instanceId;
+            Utils::QueueWaiter m_waiter;
             std::atomic<bool> m_shuttingDown = false;
         };
     }
-}
\ No newline at end of file
+}
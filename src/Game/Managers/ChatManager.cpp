@@ -95,15 +95,16 @@ namespace CppMMO
                 auto chat_message_offset = builder.CreateString(chat_message);
                 auto s_chat_packet = Protocol::CreateS_Chat(builder, player_id, chat_message_offset);
                 auto unified_packet_offset = Protocol::CreateUnifiedPacket(builder, Protocol::PacketId_S_Chat, Protocol::Packet_S_Chat, s_chat_packet.Union());
-                builder.Finish(unified_packet_offset);
+                builder.FinishSizePrefixed(unified_packet_offset);
 
-                std::span<const std::byte> send_buffer(reinterpret_cast<const std::byte*>(builder.GetBufferPointer()), builder.GetSize());
+                // Frame once and share the same buffer with every session
+                auto shared_packet = Network::PacketBuffer::Create(builder.Release());
 
                 // Broadcast to all connected sessions
                 std::lock_guard<std::mutex> lock(m_sessionsMutex);
                 for (const auto& pair : m_connectedSessions)
                 {
-                    pair.second->Send(send_buffer);
+                    pair.second->SendShared(shared_packet);
                 }
                 LOG_INFO("ChatManager: Broadcasted chat message from player {} to {} sessions: '{}'", player_id, m_connectedSessions.size(), chat_message);
             }
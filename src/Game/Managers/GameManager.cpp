@@ -3,6 +3,7 @@
 #include <random>
 #include <nlohmann/json.hpp>
 #include "Utils/MemoryPool.h"
+#include "Network/NetworkStats.h"
 
 namespace CppMMO
 {
@@ -180,6 +181,10 @@ namespace CppMMO
                             SendWorldSnapshots();
                             auto flushStart = std::chrono::high_resolution_clock::now();
                             FlushAllBatches();
+                            if (m_udpChannel)
+                            {
+                                m_udpChannel->Flush();
+                            }
                             auto tickEnd = std::chrono::high_resolution_clock::now();
                             
                             // Update performance stats
@@ -216,59 +221,99 @@ namespace CppMMO
              */
             void GameManager::ProcessPendingCommands()
             {
-                std::vector<GameCommand> commandBatch;
-                commandBatch.reserve(m_commandBatchSize);
-                
                 // Start timing for optimization
-                auto startTime = std::chrono::high_resolution_clock::now();
+                auto startTime = std::chrono::steady_clock::now();
                 auto maxDuration = std::chrono::milliseconds(m_maxProcessingTimeMs);
-                
-                // Collect commands in batches for efficient processing
-                while (commandBatch.size() < static_cast<size_t>(m_commandBatchSize))
+                size_t queueDepth = m_gameLogicQueue->GetApproxSize();
+                size_t batchLimit = static_cast<size_t>(m_commandBatchSize);
+                size_t drained = 0;
+                bool withinBudget = true;
+
+                // Full commands first, so a world restore lands before the inputs that follow it.
+                // Drain in bulk chunks into the reusable buffer; the time limit is checked once per chunk
+                while (withinBudget && drained < batchLimit && m_running.load(std::memory_order_acquire))
                 {
-                    // Check time limit to maintain stable tick rate
-                    auto currentTime = std::chrono::high_resolution_clock::now();
-                    if (currentTime - startTime >= maxDuration)
-                    {
-                        break; // Stop collecting if time limit exceeded
-                    }
-                    
-                    auto optCommand = m_gameLogicQueue->TryPopGameCommand();
-                    if (!optCommand.has_value())
+                    size_t count = m_gameLogicQueue->TryPopGameCommands(m_commandDrainBuffer.data(),
+                        std::min(m_commandDrainBuffer.size(), batchLimit - drained));
+                    if (count == 0)
                     {
                         break;
                     }
-                    
-                    if (!m_running.load(std::memory_order_acquire))
+                    drained += count;
+
+                    int64_t drainedAtUs = GetSteadyMicros();
+                    for (size_t i = 0; i < count; ++i)
                     {
-                        break;
+                        GameCommand& command = m_commandDrainBuffer[i];
+                        if (command.receivedAtUs != 0 && std::holds_alternative<PlayerInputCommandData>(command.payload))
+                        {
+                            RecordInputLatency(command.receivedAtUs, drainedAtUs);
+                        }
+                        try
+                        {
+                            ProcessGameCommand(std::move(command));
+                        }
+                        catch (const std::exception& e)
+                        {
+                            LOG_ERROR("Exception processing game command: {}", e.what());
+                        }
                     }
-                    
-                    commandBatch.push_back(std::move(optCommand.value()));
+
+                    // Check time limit to maintain stable tick rate
+                    withinBudget = std::chrono::steady_clock::now() - startTime < maxDuration;
                 }
-                
-                // Process all commands in the batch
-                for (auto& command : commandBatch)
+
+                // Hot commands from the per-producer rings, one round-robin sweep per chunk
+                while (withinBudget && drained < batchLimit && m_running.load(std::memory_order_acquire))
                 {
-                    try
+                    size_t count = m_gameLogicQueue->TryPopCompactCommands(m_compactDrainBuffer.data(),
+                        std::min(m_compactDrainBuffer.size(), batchLimit - drained));
+                    if (count == 0)
                     {
-                        ProcessGameCommand(std::move(command));
+                        break;
                     }
-                    catch (const std::exception& e)
+                    drained += count;
+
+                    int64_t drainedAtUs = GetSteadyMicros();
+                    for (size_t i = 0; i < count; ++i)
                     {
-                        LOG_ERROR("Exception processing game command: {}", e.what());
+                        const CompactGameCommand& command = m_compactDrainBuffer[i];
+                        if (command.receivedAtUs != 0 && command.type == CompactCommandType::PlayerInput)
+                        {
+                            RecordInputLatency(command.receivedAtUs, drainedAtUs);
+                        }
+                        try
+                        {
+                            ProcessCompactCommand(command);
+                        }
+                        catch (const std::exception& e)
+                        {
+                            LOG_ERROR("Exception processing game command: {}", e.what());
+                        }
                     }
+
+                    withinBudget = std::chrono::steady_clock::now() - startTime < maxDuration;
                 }
-                
-                if (!commandBatch.empty())
+
+                m_performanceStats.totalQueueDepth += queueDepth;
+                m_performanceStats.maxQueueDepth = std::max<uint64_t>(m_performanceStats.maxQueueDepth, queueDepth);
+                m_performanceStats.drainedPerTick[DrainedBucket(drained)]++;
+                if (drained > 0)
                 {
-                    auto endTime = std::chrono::high_resolution_clock::now();
-                    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
-                    m_performanceStats.totalCommandsProcessed += commandBatch.size();
-                    LOG_DEBUG("Processed batch of {} commands in {}μs", commandBatch.size(), duration.count());
+                    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+                    m_performanceStats.totalCommandsProcessed += drained;
+                    LOG_DEBUG("Processed batch of {} commands in {}μs", drained, duration.count());
                 }
             }
 
+            void GameManager::RecordInputLatency(int64_t receivedAtUs, int64_t nowUs)
+            {
+                int64_t latencyUs = nowUs - receivedAtUs;
+                m_performanceStats.inputLatencySamples++;
+                m_performanceStats.totalInputLatencyUs += latencyUs;
+                m_performanceStats.maxInputLatencyUs = std::max(m_performanceStats.maxInputLatencyUs, latencyUs);
+            }
+
             /**
              * @brief Updates the world state and player positions for the current tick.
              *
@@ -313,7 +358,7 @@ namespace CppMMO
                         // Use cached AOI for better performance
                         auto visiblePlayers = GetCachedPlayersInAOI(playerId, player.GetPosition());
                         // 월드 스냅샷을 배치에 추가 (즉시 전송하지 않음)
-                        AddSnapshotToPlayerBatch(playerId, visiblePlayers, currentServerTime);
+                        AddSnapshotToPlayerBatch(playerId, player.GetSessionId(), visiblePlayers, currentServerTime);
                     }
                 }
             }
@@ -344,9 +389,20 @@ namespace CppMMO
                     return;
                 }
                 
+                // WorldRestoreCommandData comes from the server itself, not from a session
+                if (std::holds_alternative<WorldRestoreCommandData>(command.payload))
+                {
+                    HandleWorldRestore(std::get<WorldRestoreCommandData>(command.payload));
+                    return;
+                }
+
                 // PlayerDisconnectCommandData bypasses session validation (connection already terminated)
                 if (std::holds_alternative<PlayerDisconnectCommandData>(command.payload))
                 {
+                    if (m_udpChannel)
+                    {
+                        m_udpChannel->UnregisterSession(command.senderSessionId);
+                    }
                     HandlePlayerDisconnect(std::get<PlayerDisconnectCommandData>(command.payload), nullptr);
                     return;
                 }
@@ -376,6 +432,50 @@ namespace CppMMO
                 }, command.payload);
             }
 
+            /**
+             * @brief Applies a hot command from the compact lane; same handling as ProcessGameCommand.
+             */
+            void GameManager::ProcessCompactCommand(const CompactGameCommand& command)
+            {
+                if (!m_sessionManager)
+                {
+                    LOG_ERROR("ProcessCompactCommand: ISessionManager is null.");
+                    return;
+                }
+
+                // Disconnects bypass session validation (connection already terminated)
+                if (command.type == CompactCommandType::PlayerDisconnect)
+                {
+                    if (m_udpChannel)
+                    {
+                        m_udpChannel->UnregisterSession(command.sessionId);
+                    }
+                    HandlePlayerDisconnect(PlayerDisconnectCommandData{command.playerId}, nullptr);
+                    return;
+                }
+
+                std::shared_ptr<Network::ISession> session = m_sessionManager->GetSession(command.sessionId);
+                if (!session)
+                {
+                    LOG_WARN("ProcessCompactCommand: Session {} not found.", command.sessionId);
+                    return;
+                }
+
+                if (command.type == CompactCommandType::PlayerInput)
+                {
+                    PlayerInputCommandData data;
+                    data.playerId = command.playerId;
+                    data.inputFlags = command.inputFlags;
+                    data.sequenceNumber = command.sequenceNumber;
+                    data.sessionId = command.sessionId;
+                    HandlePlayerInput(data, session);
+                }
+                else
+                {
+                    HandleEnterZone(EnterZoneCommandData{command.playerId, command.zoneId, command.sessionId}, session);
+                }
+            }
+
             /**
              * @brief Processes a player's input command, updating their movement and input state.
              *
@@ -473,6 +573,109 @@ namespace CppMMO
                 LOG_INFO("HandlePlayerDisconnect: Player {} disconnected.", data.playerId);
             }
 
+            /**
+             * @brief Rebuilds the world handed over by the previous server process.
+             *
+             * Clients never saw the restart, so nothing is broadcast: connected players go straight back
+             * into the spatial index under their new session IDs and the next snapshot carries on.
+             */
+            void GameManager::HandleWorldRestore(const WorldRestoreCommandData& data)
+            {
+                m_tickNumber = std::max(m_tickNumber, data.tickNumber);
+                for (const auto& state : data.players)
+                {
+                    Models::Player player(state.playerId, state.name, state.position);
+                    player.SetVelocity(state.velocity);
+                    player.SetRotation(state.rotation);
+                    player.SetHp(state.hp);
+                    player.SetMp(state.mp);
+                    player.SetCurrentInputFlags(state.inputFlags);
+                    player.SetLastInputSequence(state.lastInputSequence);
+                    player.SetSessionId(state.sessionId);
+                    if (state.sessionId != 0)
+                    {
+                        m_quadTree->Insert(state.playerId, state.position);
+                    }
+                    else
+                    {
+                        player.SetActive(false);
+                    }
+                    m_world->AddPlayer(std::move(player));
+                }
+                LOG_INFO("HandleWorldRestore: Restored {} players at tick {}.", data.players.size(), m_tickNumber);
+            }
+
+            /**
+             * @brief Stops the game loop and serializes the world for a socket handover.
+             *
+             * Must run while no other thread touches the world; stopping the loop first guarantees that.
+             * Players whose session is not handed over are restored as disconnected.
+             */
+            nlohmann::json GameManager::ExportHandoverState()
+            {
+                Stop();
+
+                nlohmann::json players = nlohmann::json::array();
+                for (const auto& [playerId, player] : m_world->GetAllPlayers())
+                {
+                    const Vec3& position = player.GetPosition();
+                    const Vec3& velocity = player.GetVelocity();
+                    players.push_back({
+                        {"id", playerId},
+                        {"name", player.GetName()},
+                        {"position", {position.x, position.y, position.z}},
+                        {"velocity", {velocity.x, velocity.y, velocity.z}},
+                        {"rotation", player.GetRotation()},
+                        {"hp", player.GetHp()},
+                        {"mp", player.GetMp()},
+                        {"input_flags", player.GetCurrentInputFlags()},
+                        {"last_input_sequence", player.GetLastInputSequence()},
+                        {"active", player.IsActive()},
+                    });
+                }
+                LOG_INFO("ExportHandoverState: Exported {} players at tick {}.", players.size(), m_tickNumber);
+                return nlohmann::json{{"tick", m_tickNumber}, {"players", std::move(players)}};
+            }
+
+            void GameManager::ImportHandoverState(const nlohmann::json& state, const std::unordered_map<uint64_t, uint64_t>& sessionByPlayer)
+            {
+                WorldRestoreCommandData restore;
+                try
+                {
+                    restore.tickNumber = state.value("tick", uint64_t{0});
+                    for (const auto& entry : state.value("players", nlohmann::json::array()))
+                    {
+                        RestoredPlayerState player;
+                        player.playerId = entry.at("id").get<uint64_t>();
+                        player.name = entry.value("name", "Player_" + std::to_string(player.playerId));
+                        const auto& position = entry.at("position");
+                        player.position = Vec3(position[0].get<float>(), position[1].get<float>(), position[2].get<float>());
+                        const auto& velocity = entry.at("velocity");
+                        player.velocity = Vec3(velocity[0].get<float>(), velocity[1].get<float>(), velocity[2].get<float>());
+                        player.rotation = entry.value("rotation", 0.0f);
+                        player.hp = entry.value("hp", player.hp);
+                        player.mp = entry.value("mp", player.mp);
+                        player.inputFlags = entry.value("input_flags", uint8_t{0});
+                        player.lastInputSequence = entry.value("last_input_sequence", uint32_t{0});
+                        auto session = sessionByPlayer.find(player.playerId);
+                        if (entry.value("active", false) && session != sessionByPlayer.end())
+                        {
+                            player.sessionId = session->second;
+                        }
+                        restore.players.push_back(std::move(player));
+                    }
+                }
+                catch (const nlohmann::json::exception& e)
+                {
+                    LOG_ERROR("ImportHandoverState: Malformed world state, starting empty: {}", e.what());
+                    return;
+                }
+
+                GameCommand command;
+                command.payload = GameCommandPayload{std::move(restore)};
+                command.timestamp = GetCurrentTimestamp();
+                m_gameLogicQueue->PushGameCommand(std::move(command));
+            }
 
             /**
              * @brief Sends a zone entry response to a player upon entering the game world.
@@ -525,11 +728,11 @@ namespace CppMMO
                 auto zoneEntered = Protocol::CreateS_ZoneEntered(builder, 1, playerInfo, nearPlayersVector); //zoneId = 1
 
                 auto unifiedPacket = Protocol::CreateUnifiedPacket(builder, Protocol::PacketId_S_ZoneEntered, Protocol::Packet_S_ZoneEntered, zoneEntered.Union());
-                builder.Finish(unifiedPacket);
+                builder.FinishSizePrefixed(unifiedPacket);
 
                 if (session && session->IsConnected())
                 {
-                    session->Send(std::span<const std::byte>(reinterpret_cast<const std::byte*>(builder.GetBufferPointer()), builder.GetSize()));
+                    session->SendFramed(builder.Release());
                     LOG_INFO("SendEnterZoneResponse: Sent to player {}", playerId);
                 }
             }
@@ -596,15 +799,16 @@ namespace CppMMO
                     Protocol::Packet_S_PlayerJoined, 
                     playerJoined.Union());
 
-                builder.Finish(unifiedPacket);
+                builder.FinishSizePrefixed(unifiedPacket);
+
+                // Frame once; every recipient queues a reference to the same buffer
+                auto sharedPacket = Network::PacketBuffer::Create(builder.Release());
 
                 for (const auto& [otherPlayerId, otherPlayer] : m_world->GetAllPlayers()) {
                     if (otherPlayerId != playerId && otherPlayer.IsActive()) {
                         auto session = m_sessionManager->GetSession(otherPlayer.GetSessionId());
                         if (session && session->IsConnected()) {
-                            session->Send(std::span<const std::byte>(
-                                reinterpret_cast<const std::byte*>(builder.GetBufferPointer()), 
-                                builder.GetSize()));
+                            session->SendShared(sharedPacket);
                         }
                     }
                 }
@@ -631,15 +835,16 @@ namespace CppMMO
                     Protocol::Packet_S_PlayerLeft, 
                     playerLeft.Union());
 
-                builder.Finish(unifiedPacket);
+                builder.FinishSizePrefixed(unifiedPacket);
+
+                // Frame once; every recipient queues a reference to the same buffer
+                auto sharedPacket = Network::PacketBuffer::Create(builder.Release());
 
                 for (const auto& [otherPlayerId, otherPlayer] : m_world->GetAllPlayers()) {
                     if (otherPlayerId != playerId && otherPlayer.IsActive()) {
                         auto session = m_sessionManager->GetSession(otherPlayer.GetSessionId());
                         if (session && session->IsConnected()) {
-                            session->Send(std::span<const std::byte>(
-                                reinterpret_cast<const std::byte*>(builder.GetBufferPointer()), 
-                                builder.GetSize()));
+                            session->SendShared(sharedPacket);
                         }
                     }
                 }
@@ -654,15 +859,14 @@ namespace CppMMO
              * reducing the number of system calls by combining multiple packets into a single transmission.
              *
              * @param playerId The ID of the player to receive the packet.
-             * @param packetData The packet data to add to the batch.
+             * @param framedPacket Detached size-prefixed packet; the batch takes ownership without copying.
              */
-            void GameManager::AddToPlayerBatch(uint64_t playerId, std::span<const std::byte> packetData)
+            void GameManager::AddToPlayerBatch(uint64_t playerId, flatbuffers::DetachedBuffer framedPacket)
             {
-                // Copy packet data to owned buffer
-                std::vector<std::byte> packetCopy(packetData.begin(), packetData.end());
-                m_playerBatches[playerId].push_back(std::move(packetCopy));
+                size_t packetSize = framedPacket.size();
+                m_playerBatches[playerId].push_back(std::move(framedPacket));
                 
-                LOG_DEBUG("Added packet ({} bytes) to Player {}'s batch", packetData.size(), playerId);
+                LOG_DEBUG("Added packet ({} bytes) to Player {}'s batch", packetSize, playerId);
             }
 
             /**
@@ -671,10 +875,14 @@ namespace CppMMO
              * Generates a FlatBuffers-serialized world snapshot containing visible players' states
              * and adds it to the player's batch for efficient transmission.
              *
+             * Sessions paired with the UDP channel get the snapshot as a datagram instead; it falls back
+             * to the TCP batch when the session is not paired or the snapshot exceeds the datagram limit.
+             *
              * @param playerId The ID of the player to receive the snapshot.
+             * @param sessionId The session the player is connected through.
              * @param visiblePlayers List of player IDs whose states are included in the snapshot.
              */
-            void GameManager::AddSnapshotToPlayerBatch(uint64_t playerId, const std::vector<uint64_t>& visiblePlayers, uint64_t serverTime)
+            void GameManager::AddSnapshotToPlayerBatch(uint64_t playerId, uint64_t sessionId, const std::vector<uint64_t>& visiblePlayers, uint64_t serverTime)
             {
                 // Use pooled builder to avoid dynamic allocation
                 auto pooledBuilder = Utils::MemoryPoolManager::Instance().GetPooledBuilder();
@@ -692,7 +900,9 @@ namespace CppMMO
                         const auto& player = playerOpt.value().get();
                         auto pos = Protocol::CreateVec3(builder, player.GetPosition().x, player.GetPosition().y, player.GetPosition().z);
                         auto vel = Protocol::CreateVec3(builder, player.GetVelocity().x, player.GetVelocity().y, player.GetVelocity().z);
-                        auto playerState = Protocol::CreatePlayerState(builder, visiblePlayerId, pos, vel, player.IsActive());
+                        // last_input_sequence lets clients time input-to-snapshot latency
+                        auto playerState = Protocol::CreatePlayerState(builder, visiblePlayerId, pos, vel, player.GetRotation(),
+                            player.GetHp(), player.GetMp(), player.GetLastInputSequence());
                         playerStates.push_back(playerState);
                     }
                 }
@@ -712,13 +922,22 @@ namespace CppMMO
                     Protocol::Packet_S_WorldSnapshot, 
                     snapshot.Union());
 
-                builder.Finish(unifiedPacket);
+                builder.FinishSizePrefixed(unifiedPacket);
+
+                if (m_udpChannel)
+                {
+                    // Datagrams carry the bare packet after their own tick header
+                    std::span<const std::byte> packetBody(
+                        reinterpret_cast<const std::byte*>(builder.GetBufferPointer()) + sizeof(flatbuffers::uoffset_t),
+                        builder.GetSize() - sizeof(flatbuffers::uoffset_t));
+                    if (m_udpChannel->QueueSnapshot(sessionId, m_tickNumber, packetBody))
+                    {
+                        return;
+                    }
+                }
 
                 // Add to player's batch
-                std::span<const std::byte> packetData(
-                    reinterpret_cast<const std::byte*>(builder.GetBufferPointer()), 
-                    builder.GetSize());
-                AddToPlayerBatch(playerId, packetData);
+                AddToPlayerBatch(playerId, builder.Release());
 
                 LOG_DEBUG("Added S_WorldSnapshot to Player {}'s batch (tick {}, {} visible players)", 
                          playerId, m_tickNumber, visiblePlayers.size());
@@ -730,6 +949,9 @@ namespace CppMMO
              * Sends all batched packets for each player in a single transmission, then clears
              * the batches for the next tick. This significantly reduces system call overhead
              * by combining multiple packets into single network operations.
+             *
+             * Batches are staged per I/O context and handed over with one posted task per context,
+             * so the session writers are woken on their own threads rather than from the game thread.
              */
             void GameManager::FlushAllBatches()
             {
@@ -753,23 +975,16 @@ namespace CppMMO
                         continue;
                     }
 
-                    // Convert owned buffers to spans for SendBatch
-                    std::vector<std::span<const std::byte>> packetSpans;
-                    packetSpans.reserve(packets.size());
-                    for (const auto& packet : packets) {
-                        packetSpans.emplace_back(packet.data(), packet.size());
-                    }
-
-                    // Send batch to player
-                    session->SendBatch(packetSpans);
-                    
                     totalBatches++;
                     totalPackets += packets.size();
-                    
-                    // Clear batch for next tick
+
+                    // Ownership moves to the mailbox, leaving the batch empty for the next tick
+                    m_outboundMailbox.Stage(std::move(session), std::move(packets));
                     packets.clear();
                 }
 
+                m_outboundMailbox.Flush();
+
                 if (totalBatches > 0) {
                     LOG_DEBUG("Flushed {} batches containing {} total packets", totalBatches, totalPackets);
                 }
@@ -866,6 +1081,22 @@ namespace CppMMO
                         avgCommandProcessingUs, avgWorldUpdateUs, avgSnapshotUs);
                 LOG_INFO("  AOI Cache - Hit Rate: {:.1f}%, Skipped: {}, Executed: {}", 
                         aoiCacheHitRate, m_performanceStats.totalAOIQueriesSkipped, m_performanceStats.totalAOIQueriesExecuted);
+                LOG_INFO("  Command queue - Avg depth: {}, Max depth: {}, Drained/tick [0|1-7|8-31|32-127|128-511|512+]: {}|{}|{}|{}|{}|{}",
+                        m_performanceStats.totalQueueDepth / interval, m_performanceStats.maxQueueDepth,
+                        m_performanceStats.drainedPerTick[0], m_performanceStats.drainedPerTick[1], m_performanceStats.drainedPerTick[2],
+                        m_performanceStats.drainedPerTick[3], m_performanceStats.drainedPerTick[4], m_performanceStats.drainedPerTick[5]);
+                uint64_t compactOverflows = m_gameLogicQueue->GetCompactOverflowCount();
+                if (compactOverflows != m_lastCompactOverflows) {
+                    LOG_WARN("  Command rings full - {} hot commands spilled past their ring", compactOverflows - m_lastCompactOverflows);
+                    m_lastCompactOverflows = compactOverflows;
+                }
+                if (m_performanceStats.inputLatencySamples > 0) {
+                    LOG_INFO("  Input latency (read -> tick) - Avg: {}μs, Max: {}μs, Inputs: {}",
+                            m_performanceStats.totalInputLatencyUs / static_cast<int64_t>(m_performanceStats.inputLatencySamples),
+                            m_performanceStats.maxInputLatencyUs, m_performanceStats.inputLatencySamples);
+                }
+                Network::NetworkStats::Report(Network::NetworkStats::Instance().Collect(), interval);
+                Utils::MemoryPoolManager::Instance().PrintStats();
                 
                 // Reset stats for next interval
                 m_performanceStats = PerformanceStats{};
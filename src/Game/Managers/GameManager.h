@@ -5,7 +5,10 @@
 #include "Game/Models/Player.h"
 #include "Game/Spatial/QuadTree.h"
 #include "Network/ISessionManager.h"
+#include "Network/UdpChannel.h"
+#include "Network/OutboundMailbox.h"
 #include "protocol_generated.h"
+#include <nlohmann/json.hpp>
 
 /**
  * Manages core game logic, player sessions, and world state for a multiplayer online game.
@@ -28,10 +31,21 @@ namespace CppMMO
                 void Start();
                 void Stop();
 
+                // Routes per-tick snapshots of UDP-paired sessions over the given channel; call before Start()
+                void SetUdpChannel(std::shared_ptr<Network::UdpChannel> udpChannel) { m_udpChannel = std::move(udpChannel); }
+                // I/O threads per io_context, so each tick's batches are spread over all of them; call before Start()
+                void SetIoThreadsPerContext(size_t threads) { m_outboundMailbox.SetThreadsPerContext(threads); }
+
+                // Socket handover: stops the game loop and serializes the world for the next process
+                nlohmann::json ExportHandoverState();
+                // Queues the exported world for the game loop; sessionByPlayer maps player IDs to resumed sessions
+                void ImportHandoverState(const nlohmann::json& state, const std::unordered_map<uint64_t, uint64_t>& sessionByPlayer);
+
             private:
                 // Core components
                 std::shared_ptr<GameLogicQueue> m_gameLogicQueue;
                 std::shared_ptr<Network::ISessionManager> m_sessionManager;
+                std::shared_ptr<Network::UdpChannel> m_udpChannel;
                 std::unique_ptr<Models::World> m_world;
                 std::unique_ptr<Spatial::QuadTree> m_quadTree;
 
@@ -52,11 +66,15 @@ namespace CppMMO
                 // Performance settings
                 int m_commandBatchSize = 500;  // Optimized: 100 → 500
                 int m_maxProcessingTimeMs = 10; // Time limit for command processing
+                static constexpr size_t COMMAND_DRAIN_CHUNK = 64; // Commands per bulk dequeue; time limit checked per chunk
+                std::vector<GameCommand> m_commandDrainBuffer = std::vector<GameCommand>(COMMAND_DRAIN_CHUNK);
+                std::vector<CompactGameCommand> m_compactDrainBuffer = std::vector<CompactGameCommand>(COMMAND_DRAIN_CHUNK);
                 int m_aoiUpdateInterval = 3;    // Update AOI every 3 ticks instead of every tick
                 float m_aoiPositionThreshold = 10.0f; // Force AOI update if player moved > 10 units
 
                 // Tick-based batching system
-                std::unordered_map<uint64_t, std::vector<std::vector<std::byte>>> m_playerBatches;
+                std::unordered_map<uint64_t, std::vector<flatbuffers::DetachedBuffer>> m_playerBatches;  // Size-prefixed packets
+                Network::OutboundMailbox m_outboundMailbox;  // Hands each tick's batches to the owning I/O threads
                 
                 // AOI caching system for performance optimization
                 struct AOICache {
@@ -74,9 +92,28 @@ namespace CppMMO
                     std::chrono::microseconds totalCommandProcessingTime{0};
                     std::chrono::microseconds totalWorldUpdateTime{0};
                     std::chrono::microseconds totalSnapshotTime{0};
+                    // Socket read -> start of the tick that applies the input
+                    uint64_t inputLatencySamples = 0;
+                    int64_t totalInputLatencyUs = 0;
+                    int64_t maxInputLatencyUs = 0;
+                    // GameLogicQueue depth sampled at the start of each drain
+                    uint64_t totalQueueDepth = 0;
+                    uint64_t maxQueueDepth = 0;
+                    // Ticks by commands drained: 0, 1-7, 8-31, 32-127, 128-511, 512+
+                    std::array<uint64_t, 6> drainedPerTick{};
                 };
+                static size_t DrainedBucket(size_t drained)
+                {
+                    if (drained == 0) return 0;
+                    if (drained < 8) return 1;
+                    if (drained < 32) return 2;
+                    if (drained < 128) return 3;
+                    if (drained < 512) return 4;
+                    return 5;
+                }
                 PerformanceStats m_performanceStats;
                 uint64_t m_lastStatsReportTick = 0;
+                uint64_t m_lastCompactOverflows = 0;
                 static constexpr uint64_t STATS_REPORT_INTERVAL = 300; // Report every 5 seconds at 60 TPS
 
                 void GameLoop();
@@ -84,15 +121,18 @@ namespace CppMMO
                 void UpdateWorld(float deltaTime);
                 void SendWorldSnapshots();
                 void ProcessGameCommand(GameCommand command);
+                void ProcessCompactCommand(const CompactGameCommand& command);
+                void RecordInputLatency(int64_t receivedAtUs, int64_t nowUs);
 
                 // Tick-based batching methods
-                void AddToPlayerBatch(uint64_t playerId, std::span<const std::byte> packetData);
-                void AddSnapshotToPlayerBatch(uint64_t playerId, const std::vector<uint64_t>& visiblePlayers, uint64_t serverTime);
+                void AddToPlayerBatch(uint64_t playerId, flatbuffers::DetachedBuffer framedPacket);
+                void AddSnapshotToPlayerBatch(uint64_t playerId, uint64_t sessionId, const std::vector<uint64_t>& visiblePlayers, uint64_t serverTime);
                 void FlushAllBatches();
 
                 void HandlePlayerInput(const PlayerInputCommandData& data, std::shared_ptr<Network::ISession> session);
                 void HandleEnterZone(const EnterZoneCommandData& data, std::shared_ptr<Network::ISession> session);
                 void HandlePlayerDisconnect(const PlayerDisconnectCommandData& data, std::shared_ptr<Network::ISession> session);
+                void HandleWorldRestore(const WorldRestoreCommandData& data);
            
                 std::vector<uint64_t> GetPlayersInAOI(const Vec3& position);
                 std::vector<uint64_t> GetCachedPlayersInAOI(uint64_t playerId, const Vec3& position);
@@ -0,0 +1,42 @@
+#include "pch.h"
+#include "HeartbeatPacketHandler.h"
+#include "Utils/MemoryPool.h"
+
+namespace CppMMO
+{
+    namespace Game
+    {
+        namespace PacketHandlers
+        {
+            void HeartbeatPacketHandler::operator()(std::shared_ptr<Network::ISession> session, const Protocol::UnifiedPacket* unifiedPacket) const
+            {
+                if (!session)
+                {
+                    LOG_ERROR("Error: Session is null in HeartbeatPacketHandler.");
+                    return;
+                }
+
+                const Protocol::C_Heartbeat* c_heartbeat_packet = unifiedPacket->data_as_C_Heartbeat();
+                if (!c_heartbeat_packet)
+                {
+                    LOG_ERROR("Error: Session {}: Received C_Heartbeat packet with null data.", session->GetSessionId());
+                    return;
+                }
+
+                uint64_t serverTime = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count());
+
+                auto pooledBuilder = Utils::MemoryPoolManager::Instance().GetPooledBuilder();
+                auto& builder = *pooledBuilder;
+                auto s_heartbeat_offset = Protocol::CreateS_Heartbeat(builder, c_heartbeat_packet->client_time(), serverTime);
+                auto unified_packet_offset = Protocol::CreateUnifiedPacket(builder,
+                                                                           Protocol::PacketId_S_Heartbeat,
+                                                                           Protocol::Packet_S_Heartbeat,
+                                                                           s_heartbeat_offset.Union());
+                builder.FinishSizePrefixed(unified_packet_offset);
+
+                session->SendFramed(builder.Release());
+            }
+        }
+    }
+}
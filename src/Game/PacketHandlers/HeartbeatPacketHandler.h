@@ -0,0 +1,25 @@
+#pragma once
+#include "pch.h"
+#include "Network/ISession.h"
+#include "protocol_generated.h"
+
+namespace CppMMO
+{
+    namespace Game
+    {
+        namespace PacketHandlers
+        {
+            /**
+             * @brief Answers C_Heartbeat with S_Heartbeat so the client can measure RTT.
+             *
+             * Receiving the packet already refreshed the session's read-idle deadline; the reply
+             * keeps the client's own idle detection happy on quiet connections.
+             */
+            class HeartbeatPacketHandler
+            {
+            public:
+                void operator()(std::shared_ptr<Network::ISession> session, const Protocol::UnifiedPacket* unifiedPacket) const;
+            };
+        }
+    }
+}
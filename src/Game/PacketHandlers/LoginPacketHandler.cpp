@@ -9,8 +9,9 @@ namespace CppMMO
     {
         namespace PacketHandlers
         {
-            LoginPacketHandler::LoginPacketHandler(boost::asio::io_context& ioc, std::shared_ptr<CppMMO::Game::Services::AuthService> authService)
-                : m_ioc(ioc), m_authService(authService)
+            LoginPacketHandler::LoginPacketHandler(boost::asio::io_context& ioc, std::shared_ptr<CppMMO::Game::Services::AuthService> authService,
+                                                   std::shared_ptr<Network::UdpChannel> udpChannel)
+                : m_ioc(ioc), m_authService(authService), m_udpChannel(std::move(udpChannel))
             {
                 if (!m_authService)
                 {
@@ -53,12 +54,13 @@ namespace CppMMO
                     return;
                 }
 
+                const bool acceptLz4 = c_login_packet->accept_lz4();
                 std::weak_ptr<Network::ISession> weakSession = session;
 
                 m_authService->VerifySessionTicketAsync(sessionTicket, playerId,
-                    [this, weakSession, commandId, sessionTicket, playerId](const CppMMO::Game::Services::VerifyTicketResponse& authResponse)
+                    [this, weakSession, commandId, sessionTicket, playerId, acceptLz4](const CppMMO::Game::Services::VerifyTicketResponse& authResponse)
                     {
-                        boost::asio::post(m_ioc, [this, weakSession, commandId, sessionTicket, playerId, authResponse]()
+                        boost::asio::post(m_ioc, [this, weakSession, commandId, sessionTicket, playerId, acceptLz4, authResponse]()
                         {
                             std::shared_ptr<Network::ISession> session = weakSession.lock();
                             if (!session || !session->IsConnected())
@@ -82,13 +84,18 @@ namespace CppMMO
                                                                                      0,
                                                                                      100,
                                                                                      100);
-                                auto s_login_success_offset = Protocol::CreateS_LoginSuccess(builder, player_info_offset, commandId);
+                                // Pairing token for the optional UDP snapshot channel (0 = TCP only)
+                                uint64_t udpToken = m_udpChannel ? m_udpChannel->RegisterSession(session->GetSessionId()) : 0;
+                                uint16_t udpPort = m_udpChannel ? m_udpChannel->GetPort() : 0;
+                                // Compression starts with the first snapshot batch after S_LoginSuccess
+                                bool lz4Enabled = acceptLz4 && session->EnableCompression();
+                                auto s_login_success_offset = Protocol::CreateS_LoginSuccess(builder, player_info_offset, commandId, udpToken, udpPort, lz4Enabled);
                                 auto unified_packet_offset = Protocol::CreateUnifiedPacket(builder, 
                                                                                            Protocol::PacketId_S_LoginSuccess, 
                                                                                            Protocol::Packet_S_LoginSuccess, 
                                                                                            s_login_success_offset.Union());
-                                builder.Finish(unified_packet_offset);
-                                session->Send(std::span<const std::byte>(reinterpret_cast<const std::byte*>(builder.GetBufferPointer()), builder.GetSize()));
+                                builder.FinishSizePrefixed(unified_packet_offset);
+                                session->SendFramed(builder.Release());
                                 LOG_INFO("--- LoginPacketHandler: Sent S_LoginSuccess ---");
                             }
                             else
@@ -113,9 +120,9 @@ namespace CppMMO
                                                                            Protocol::PacketId_S_LoginFailure, 
                                                                            Protocol::Packet_S_LoginFailure, 
                                                                            s_login_failure_offset.Union());
-                builder.Finish(unified_packet_offset);
+                builder.FinishSizePrefixed(unified_packet_offset);
 
-                session->Send(std::span<const std::byte>(reinterpret_cast<const std::byte*>(builder.GetBufferPointer()), builder.GetSize()));
+                session->SendFramed(builder.Release());
             }
         }
     }
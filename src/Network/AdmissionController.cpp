@@ -0,0 +1,144 @@
+#include "pch.h"
+#include "AdmissionController.h"
+
+namespace ip = boost::asio::ip;
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        AdmissionController::AdmissionController(const AdmissionConfig& config)
+            : m_config(config),
+              m_globalAccepts(config.accept_rate_per_second, config.accept_burst)
+        {
+        }
+
+        AdmissionResult AdmissionController::Admit(const ip::address& address, int64_t nowMs)
+        {
+            bool perAddress = !IsExempt(address) &&
+                (m_config.per_ip_max_connections > 0 || m_config.per_ip_connect_rate_per_second > 0.0);
+
+            Shard* shard = nullptr;
+            std::unique_lock<std::mutex> shardLock;
+            AddressState* state = nullptr;
+            if (perAddress)
+            {
+                shard = &ShardFor(address);
+                shardLock = std::unique_lock<std::mutex>(shard->mutex);
+                if (++shard->admitsSinceSweep >= SWEEP_INTERVAL)
+                {
+                    Sweep(*shard, nowMs);
+                }
+
+                auto [it, inserted] = shard->addresses.try_emplace(address);
+                state = &it->second;
+                if (inserted)
+                {
+                    state->connects = TokenBucket(m_config.per_ip_connect_rate_per_second, m_config.per_ip_connect_burst);
+                }
+                if (m_config.per_ip_max_connections > 0 && state->active >= m_config.per_ip_max_connections)
+                {
+                    return AdmissionResult::IpConcurrent;
+                }
+                if (state->connects.Enabled() && !state->connects.HasTokens(1.0, nowMs))
+                {
+                    return AdmissionResult::IpRate;
+                }
+            }
+
+            if (m_globalAccepts.Enabled())
+            {
+                // Lock order is shard, then global
+                std::lock_guard<std::mutex> globalLock(m_globalMutex);
+                if (!m_globalAccepts.HasTokens(1.0, nowMs))
+                {
+                    return AdmissionResult::GlobalRate;
+                }
+                m_globalAccepts.Take(1.0);
+            }
+
+            if (state)
+            {
+                if (state->connects.Enabled())
+                {
+                    state->connects.Take(1.0);
+                }
+                ++state->active;
+            }
+            return AdmissionResult::Admitted;
+        }
+
+        void AdmissionController::Release(const ip::address& address)
+        {
+            if (IsExempt(address))
+            {
+                return;
+            }
+            Shard& shard = ShardFor(address);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.addresses.find(address);
+            if (it != shard.addresses.end() && it->second.active > 0)
+            {
+                // The entry stays until a sweep so its rate bucket survives reconnects
+                --it->second.active;
+            }
+        }
+
+        void AdmissionController::Adopt(const ip::address& address)
+        {
+            if (IsExempt(address))
+            {
+                return;
+            }
+            Shard& shard = ShardFor(address);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto [it, inserted] = shard.addresses.try_emplace(address);
+            if (inserted)
+            {
+                it->second.connects = TokenBucket(m_config.per_ip_connect_rate_per_second, m_config.per_ip_connect_burst);
+            }
+            ++it->second.active;
+        }
+
+        size_t AdmissionController::GetTrackedAddressCount() const
+        {
+            size_t count = 0;
+            for (const auto& shard : m_shards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                count += shard.addresses.size();
+            }
+            return count;
+        }
+
+        bool AdmissionController::IsExempt(const ip::address& address) const
+        {
+            return m_config.exempt_loopback && address.is_loopback();
+        }
+
+        AdmissionController::Shard& AdmissionController::ShardFor(const ip::address& address)
+        {
+            return m_shards[AddressHash{}(address) % SHARD_COUNT];
+        }
+
+        size_t AdmissionController::AddressHash::operator()(const ip::address& address) const noexcept
+        {
+            if (address.is_v4())
+            {
+                return std::hash<uint32_t>{}(address.to_v4().to_uint());
+            }
+            auto bytes = address.to_v6().to_bytes();
+            return std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+        }
+
+        void AdmissionController::Sweep(Shard& shard, int64_t nowMs)
+        {
+            shard.admitsSinceSweep = 0;
+            std::erase_if(shard.addresses, [nowMs](const auto& entry)
+            {
+                const AddressState& state = entry.second;
+                return state.active == 0 && (!state.connects.Enabled() || state.connects.IsFull(nowMs));
+            });
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "pch.h"
+#include "IService.h"
+#include "TokenBucket.h"
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        /**
+         * @brief Decides, right after accept, whether a new connection may become a session.
+         *
+         * Applies a server-wide accept token bucket and, per source address, a concurrent session
+         * cap and a connect-rate bucket. Callable from every accept loop at once: per-address state
+         * lives in mutex-guarded shards and the global bucket has its own lock. Every Admitted result
+         * must be paired with one Release() for the same address when the session ends.
+         */
+        class AdmissionController
+        {
+        public:
+            explicit AdmissionController(const AdmissionConfig& config);
+
+            AdmissionResult Admit(const boost::asio::ip::address& address, int64_t nowMs);
+            void Release(const boost::asio::ip::address& address);
+            // Counts a session that was admitted by a previous process (socket handover), without any checks
+            void Adopt(const boost::asio::ip::address& address);
+
+            // Addresses currently tracked (holding sessions or still refilling their rate bucket)
+            size_t GetTrackedAddressCount() const;
+
+        private:
+            struct AddressState
+            {
+                size_t active = 0;
+                TokenBucket connects;
+            };
+
+            struct AddressHash
+            {
+                size_t operator()(const boost::asio::ip::address& address) const noexcept;
+            };
+
+            struct Shard
+            {
+                mutable std::mutex mutex;
+                std::unordered_map<boost::asio::ip::address, AddressState, AddressHash> addresses;
+                uint32_t admitsSinceSweep = 0;
+            };
+
+            static constexpr size_t SHARD_COUNT = 16;
+            static constexpr uint32_t SWEEP_INTERVAL = 1024;   // Admit calls per shard between stale-entry sweeps
+
+            bool IsExempt(const boost::asio::ip::address& address) const;
+            Shard& ShardFor(const boost::asio::ip::address& address);
+            // Drops entries with no sessions whose rate bucket has refilled; caller holds the shard lock
+            static void Sweep(Shard& shard, int64_t nowMs);
+
+            AdmissionConfig m_config;
+            std::mutex m_globalMutex;
+            TokenBucket m_globalAccepts;
+            std::array<Shard, SHARD_COUNT> m_shards;
+        };
+    }
+}
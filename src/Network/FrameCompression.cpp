@@ -0,0 +1,68 @@
+#include "pch.h"
+#include "FrameCompression.h"
+#include "NetworkStats.h"
+
+#ifdef CPPMMO_HAS_LZ4
+#include <lz4.h>
+#endif
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        namespace FrameCompression
+        {
+            bool IsAvailable()
+            {
+#ifdef CPPMMO_HAS_LZ4
+                return true;
+#else
+                return false;
+#endif
+            }
+
+            std::optional<std::vector<std::byte>> Compress(std::span<const std::byte> frames)
+            {
+#ifdef CPPMMO_HAS_LZ4
+                if (frames.empty() || frames.size() > static_cast<size_t>(LZ4_MAX_INPUT_SIZE))
+                {
+                    return std::nullopt;
+                }
+
+                auto start = std::chrono::steady_clock::now();
+
+                constexpr size_t PREFIX_SIZE = 2 * sizeof(uint32_t);
+                int inputSize = static_cast<int>(frames.size());
+                std::vector<std::byte> output(PREFIX_SIZE + static_cast<size_t>(LZ4_compressBound(inputSize)));
+
+                int compressedSize = LZ4_compress_default(
+                    reinterpret_cast<const char*>(frames.data()),
+                    reinterpret_cast<char*>(output.data() + PREFIX_SIZE),
+                    inputSize,
+                    static_cast<int>(output.size() - PREFIX_SIZE));
+
+                auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+                if (compressedSize <= 0 || PREFIX_SIZE + static_cast<size_t>(compressedSize) >= frames.size())
+                {
+                    // Incompressible batch: the caller sends it as is
+                    NetworkStats::Instance().RecordCompression(frames.size(), frames.size(), elapsed.count());
+                    return std::nullopt;
+                }
+
+                uint32_t header = COMPRESSED_FLAG | static_cast<uint32_t>(sizeof(uint32_t) + compressedSize);
+                uint32_t uncompressedSize = static_cast<uint32_t>(frames.size());
+                std::memcpy(output.data(), &header, sizeof(uint32_t));
+                std::memcpy(output.data() + sizeof(uint32_t), &uncompressedSize, sizeof(uint32_t));
+                output.resize(PREFIX_SIZE + static_cast<size_t>(compressedSize));
+
+                NetworkStats::Instance().RecordCompression(frames.size(), output.size(), elapsed.count());
+                return output;
+#else
+                (void)frames;
+                return std::nullopt;
+#endif
+            }
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "pch.h"
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        /**
+         * @brief LZ4 compression of outbound frame batches.
+         *
+         * A compressed frame reuses the normal 4-byte little-endian length header with the high bit
+         * set. Its body is the uncompressed size (uint32, little-endian) followed by one LZ4 block
+         * that decompresses to a run of ordinary length-prefixed frames:
+         *
+         *   [0x80000000 | bodyLength][uncompressedSize][LZ4 block]
+         *
+         * Only clients that set `accept_lz4` in C_Login receive compressed frames. Compression is
+         * available when the server is built with liblz4 (CPPMMO_HAS_LZ4).
+         */
+        namespace FrameCompression
+        {
+            constexpr uint32_t COMPRESSED_FLAG = 0x80000000u;
+
+            bool IsAvailable();
+
+            /**
+             * @brief Compresses already-framed packets into a single compressed frame.
+             * @return The compressed frame including its header, or std::nullopt when compression is
+             *         unavailable or would not make the batch smaller.
+             */
+            std::optional<std::vector<std::byte>> Compress(std::span<const std::byte> frames);
+        }
+    }
+}
@@ -37,12 +37,18 @@ namespace CppMMO
              *  @param id The packet ID whose handler should be removed.
              */
             virtual void UnregisterHandler(PacketId id) = 0;
+            /**
+             *  @brief Registers a handler that runs on the I/O thread, bypassing the JobQueue.
+             *  @details For small, cheap game packets. The packet is verified on the I/O thread and
+             *           the handler must not block; it only runs for packets up to the inline size limit.
+             */
+            virtual void RegisterInlineHandler(PacketId id, const PacketHandler& handler) = 0;
             /**
              *  @brief Analyzes received packets and forwards them to registered handlers.
              *  @param session The session that received the packet.
-             *  @param packet The top-level packet object parsed through FlatBuffers.
+             *  @param packet The packet body (without length header). Only valid for the duration of the call.
              */
-            virtual void HandlePacket(const std::shared_ptr<ISession>& session, const std::vector<std::byte>& packet) = 0;
+            virtual void HandlePacket(const std::shared_ptr<ISession>& session, std::span<const std::byte> packet) = 0;
         
             virtual void DispatchPacket(Protocol::PacketId id, const std::shared_ptr<ISession>& session, const Protocol::UnifiedPacket* packet) = 0;
         };
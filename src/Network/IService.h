@@ -6,11 +6,119 @@ namespace CppMMO
     {
         class ISession;
 
+        // What a session does when its outbound queue exceeds the byte budget
+        enum class SlowConsumerPolicy
+        {
+            DropSnapshots,  // Keep only the newest snapshot batch; reliable packets are still queued
+            Disconnect      // Disconnect if the session stays over budget longer than the grace period
+        };
+
+        // Ingress packet classes, each with its own rate budget
+        enum class IngressClass : size_t
+        {
+            Input,      // C_PlayerInput
+            Chat,       // C_Chat
+            Control,    // Login, zone, heartbeat and anything unrecognised
+            Count
+        };
+
+        // Token bucket budgets for one ingress class; a rate of 0 disables that budget
+        struct IngressLimit
+        {
+            double packets_per_second = 0.0;
+            double packet_burst = 0.0;
+            double bytes_per_second = 0.0;
+            double byte_burst = 0.0;
+        };
+
+        struct IngressConfig
+        {
+            bool enabled = true;
+            size_t max_frame_bytes = 4096;  // Larger client frames are a protocol violation and disconnect
+            std::array<IngressLimit, static_cast<size_t>(IngressClass::Count)> limits{{
+                {60.0, 30.0, 16384.0, 8192.0},    // Input: client sends at 30Hz
+                {5.0, 10.0, 8192.0, 8192.0},      // Chat
+                {10.0, 20.0, 65536.0, 65536.0},   // Control
+            }};
+        };
+
+        struct SessionConfig
+        {
+            size_t send_budget_bytes = 256 * 1024;
+            SlowConsumerPolicy slow_consumer_policy = SlowConsumerPolicy::DropSnapshots;
+            std::chrono::milliseconds slow_consumer_grace{3000};
+
+            // Dead-connection detection; 0 disables the check
+            // No bytes (including C_Heartbeat) received. Off by default: the shipped clients send no
+            // heartbeat, so a player who stops moving would be dropped
+            std::chrono::milliseconds read_idle_timeout{0};
+            std::chrono::milliseconds write_stall_timeout{15000};  // One write has not completed
+
+            // Snapshot batches at least this large are LZ4-compressed for clients that opted in; 0 disables
+            size_t compression_threshold_bytes = 1024;
+
+            // Linux: writes at least this large are sent with MSG_ZEROCOPY; 0 disables. Pinning pages
+            // costs more than copying small sends, so this only pays off from roughly 10KB up.
+            size_t zerocopy_threshold_bytes = 0;
+
+            // Linux SO_BUSY_POLL budget for session sockets in microseconds; 0 leaves the system
+            // default. Values above net.core.busy_read need CAP_NET_ADMIN.
+            int socket_busy_poll_us = 0;
+
+            IngressConfig ingress{};
+        };
+
+        // How network I/O threads are mapped onto io_contexts
+        enum class IoMode
+        {
+            Shared,     // All I/O threads run one io_context
+            PerCore,    // One io_context per I/O thread; sessions stay on the context that accepted them
+            BusyPoll    // PerCore layout, but each I/O thread spins on its context before blocking
+        };
+
+        // Connection admission applied right after accept; a rate of 0 (or a cap of 0) disables that check
+        struct AdmissionConfig
+        {
+            double accept_rate_per_second = 500.0;      // Server-wide
+            double accept_burst = 1000.0;
+            // Per-address limits are off by default: behind NAT, a proxy or docker's port publishing,
+            // many players (and the load tests) share one source address
+            size_t per_ip_max_connections = 0;          // Concurrent sessions per source address
+            double per_ip_connect_rate_per_second = 0.0;
+            double per_ip_connect_burst = 10.0;
+            bool exempt_loopback = true;                // Per-address limits skip 127.0.0.0/8 and ::1 (load tests)
+        };
+
+        // Outcome of admitting an accepted connection
+        enum class AdmissionResult : size_t
+        {
+            Admitted,
+            GlobalRate,     // Server-wide accept rate exhausted
+            IpConcurrent,   // Source address already holds its maximum number of sessions
+            IpRate,         // Source address is connecting faster than its rate
+            Capacity,       // max_connections reached
+            Count
+        };
+
         struct ServiceConfig
         {
             std::string host;
             unsigned short port;
             int worker_threads;
+            IoMode io_mode = IoMode::Shared;
+            bool reuse_port = true;     // PerCore: one SO_REUSEPORT acceptor per context instead of round-robin
+            std::chrono::milliseconds reaper_interval{1000};   // Timer wheel tick for expired sessions
+            size_t registered_receive_chunks = 1024;            // io_uring builds: registered receive chunks per io_context
+            size_t max_connections = 600;                       // New connections beyond this are closed; 0 = unlimited (game_config.json max_concurrent_connections)
+            int listen_backlog = 1024;                          // Capped by net.core.somaxconn
+            size_t accept_concurrency = 4;                      // Outstanding async_accepts per listening socket
+            std::chrono::microseconds busy_poll_window{200};    // BusyPoll: idle spin time before an I/O thread blocks
+            std::string handover_socket_path;                   // Unix socket for zero-downtime restarts; empty = disabled
+            bool takeover = false;                              // Start by taking sockets over from the running process
+            bool handover_sessions = true;                      // Pass client connections too, not only the listeners
+            std::chrono::milliseconds handover_drain_timeout{500};  // Per session: time to flush writes before detaching
+            SessionConfig session{};
+            AdmissionConfig admission{};
         };
 
         class IService
@@ -1,5 +1,6 @@
 #pragma once
 #include "pch.h"
+#include "PacketBuffer.h"
 #include <span>
 #include <cstddef>
 
@@ -29,15 +30,61 @@ namespace CppMMO
 
             virtual boost::asio::ip::tcp::endpoint GetRemoteEndpoint() const = 0;
 
+            // Executor of the I/O context that owns this session's socket
+            virtual boost::asio::any_io_executor GetExecutor() = 0;
+
             virtual bool IsConnected() const = 0;
 
             virtual void Send(std::span<const std::byte> data) = 0;
-            virtual void SendBatch(const std::vector<std::span<const std::byte>>& packets) = 0;
+            /**
+             * @brief Queues a packet that already carries its 4-byte length prefix.
+             *
+             * @details Takes the detached buffer of a builder finished with `FinishSizePrefixed`;
+             *          the bytes are written as they are and the buffer goes back to the packet
+             *          allocator once sent.
+             */
+            virtual void SendFramed(flatbuffers::DetachedBuffer packet) = 0;
+            /**
+             * @brief Queues the per-tick snapshot batch as a single write.
+             *
+             * @details `framedPackets` are size-prefixed packets. They are gathered into the write as
+             *          they are, and copied into one buffer only when LZ4 compression needs contiguous
+             *          input. Batches are treated as droppable: when the session is over its send
+             *          budget under the DropSnapshots policy, an unsent batch is replaced by the newer one.
+             */
+            virtual void SendBatch(std::vector<flatbuffers::DetachedBuffer> framedPackets) = 0;
+            /**
+             * @brief Queues an already-framed shared packet without copying its payload.
+             *
+             * @details Used for broadcasts: the packet is encoded once and the same buffer is
+             *          referenced by every recipient's write queue until it has been sent.
+             */
+            virtual void SendShared(SharedPacket packet) = 0;
 
             virtual void SetOnDisconnectedCallback(const std::function<void(std::shared_ptr<ISession>)>& callback) = 0;
             virtual uint64_t GetSessionId() const = 0;
             virtual uint64_t GetPlayerId() const = 0;
             virtual void SetPlayerId(uint64_t playerId) = 0;
+
+            /**
+             * @brief Turns on LZ4 compression of snapshot batches for a client that opted in at login.
+             * @return false if the server cannot compress (built without LZ4 or disabled by config).
+             */
+            virtual bool EnableCompression() = 0;
+
+            // Bytes queued for this session that have not been written to the socket yet
+            virtual size_t GetQueuedBytes() const = 0;
+
+            /**
+             * @brief Per-session packet order through JobProcessor.
+             *
+             * @details NextPacketSequence() stamps a job on the I/O thread; the worker that dispatches
+             *          it calls MarkPacketDispatched(), which returns false if a later packet of this
+             *          session was already dispatched. Packets PacketManager handles inline on the
+             *          I/O thread never take a sequence.
+             */
+            virtual uint32_t NextPacketSequence() = 0;
+            virtual bool MarkPacketDispatched(uint32_t sequence) = 0;
         };
     }
 }
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "pch.h"
+#include "IngressLimiter.h"
+#include "NetworkStats.h"
+#include "protocol_generated.h"
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        IngressLimiter::IngressLimiter(const IngressConfig& config)
+            : m_enabled(config.enabled)
+        {
+            for (size_t i = 0; i < m_buckets.size(); ++i)
+            {
+                const auto& limit = config.limits[i];
+                if (limit.packets_per_second > 0.0)
+                {
+                    m_buckets[i].packets = TokenBucket(limit.packets_per_second, limit.packet_burst);
+                }
+                if (limit.bytes_per_second > 0.0)
+                {
+                    // A single frame must always fit in a full bucket
+                    m_buckets[i].bytes = TokenBucket(limit.bytes_per_second, std::max(limit.byte_burst, static_cast<double>(config.max_frame_bytes)));
+                }
+            }
+        }
+
+        bool IngressLimiter::Admit(std::span<const std::byte> body, int64_t nowMs)
+        {
+            if (!m_enabled)
+            {
+                return true;
+            }
+
+            IngressClass ingressClass = Classify(body);
+            auto& buckets = m_buckets[static_cast<size_t>(ingressClass)];
+            double bytes = static_cast<double>(body.size());
+
+            // Check both budgets before charging either, so a drop does not consume tokens
+            bool packetOk = !buckets.packets.Enabled() || buckets.packets.HasTokens(1.0, nowMs);
+            bool bytesOk = !buckets.bytes.Enabled() || buckets.bytes.HasTokens(bytes, nowMs);
+            if (packetOk && bytesOk)
+            {
+                if (buckets.packets.Enabled()) buckets.packets.Take(1.0);
+                if (buckets.bytes.Enabled()) buckets.bytes.Take(bytes);
+                return true;
+            }
+
+            ++m_droppedPackets;
+            m_droppedBytes += body.size();
+            NetworkStats::Instance().RecordIngressDrop(ingressClass, body.size());
+            return false;
+        }
+
+        std::optional<uint16_t> IngressLimiter::PeekPacketId(std::span<const std::byte> body)
+        {
+            auto read = [body](size_t offset, auto& value)
+            {
+                if (offset > body.size() || body.size() - offset < sizeof(value)) return false;
+                std::memcpy(&value, body.data() + offset, sizeof(value));
+                return true;
+            };
+
+            // Root uoffset -> table; table starts with an soffset back to its vtable
+            uint32_t tablePos = 0;
+            int32_t vtableDistance = 0;
+            if (!read(0, tablePos) || !read(tablePos, vtableDistance))
+            {
+                return std::nullopt;
+            }
+            int64_t vtablePos = static_cast<int64_t>(tablePos) - vtableDistance;
+            uint16_t vtableSize = 0;
+            if (vtablePos < 0 || !read(static_cast<size_t>(vtablePos), vtableSize))
+            {
+                return std::nullopt;
+            }
+
+            // vtable: [vtable size][table size][field 0 offset]...; `id` is field 0
+            constexpr size_t ID_FIELD_SLOT = 2 * sizeof(uint16_t);
+            uint16_t idFieldOffset = 0;
+            if (vtableSize < ID_FIELD_SLOT + sizeof(uint16_t) || !read(static_cast<size_t>(vtablePos) + ID_FIELD_SLOT, idFieldOffset))
+            {
+                return static_cast<uint16_t>(Protocol::PacketId_NONE);
+            }
+            if (idFieldOffset == 0)
+            {
+                return static_cast<uint16_t>(Protocol::PacketId_NONE);
+            }
+
+            uint16_t id = 0;
+            if (!read(static_cast<size_t>(tablePos) + idFieldOffset, id))
+            {
+                return std::nullopt;
+            }
+            return id;
+        }
+
+        IngressClass IngressLimiter::Classify(std::span<const std::byte> body)
+        {
+            auto id = PeekPacketId(body);
+            if (!id)
+            {
+                return IngressClass::Control;
+            }
+            switch (*id)
+            {
+                case Protocol::PacketId_C_PlayerInput:
+                    return IngressClass::Input;
+                case Protocol::PacketId_C_Chat:
+                    return IngressClass::Chat;
+                default:
+                    return IngressClass::Control;
+            }
+        }
+    }
+}
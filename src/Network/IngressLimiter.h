@@ -0,0 +1,46 @@
+#pragma once
+#include "pch.h"
+#include "IService.h"
+#include "TokenBucket.h"
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        /**
+         * @brief Per-session token buckets applied to received frames on the I/O thread.
+         *
+         * Each frame is classified by peeking at the UnifiedPacket id with bounds-checked reads
+         * (no verifier, no copy) and charged against its class's packet-count and byte budgets.
+         * Frames over budget are dropped before they are copied into a slab or queued, so flood
+         * traffic costs only the header parse. Owned and used by one session's ReadLoop only.
+         */
+        class IngressLimiter
+        {
+        public:
+            explicit IngressLimiter(const IngressConfig& config);
+
+            // Returns false if the frame must be dropped; `nowMs` is steady-clock milliseconds.
+            bool Admit(std::span<const std::byte> body, int64_t nowMs);
+
+            uint64_t GetDroppedPackets() const { return m_droppedPackets; }
+            uint64_t GetDroppedBytes() const { return m_droppedBytes; }
+
+            // Reads UnifiedPacket.id from an unverified buffer; nullopt if the table is malformed.
+            static std::optional<uint16_t> PeekPacketId(std::span<const std::byte> body);
+            static IngressClass Classify(std::span<const std::byte> body);
+
+        private:
+            struct ClassBuckets
+            {
+                TokenBucket packets;
+                TokenBucket bytes;
+            };
+
+            bool m_enabled;
+            std::array<ClassBuckets, static_cast<size_t>(IngressClass::Count)> m_buckets;
+            uint64_t m_droppedPackets = 0;
+            uint64_t m_droppedBytes = 0;
+        };
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include "pch.h"
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        // Link embedded in every element of an IntrusiveMpscQueue
+        struct MpscNode
+        {
+            std::atomic<MpscNode*> next{nullptr};
+        };
+
+        /**
+         * @brief Unbounded multi-producer / single-consumer queue of heap nodes (Vyukov's intrusive queue).
+         *
+         * An empty queue is three pointers and an embedded stub node, so an idle owner pays nothing
+         * for preallocated blocks. Push is one atomic exchange and is wait-free; Pop may return
+         * nullptr while a producer is between its exchange and its link store, in which case the
+         * element shows up on a later call. `T` must derive from MpscNode. Pop and Empty are
+         * consumer-only.
+         */
+        template <typename T>
+        class IntrusiveMpscQueue
+        {
+        public:
+            IntrusiveMpscQueue()
+                : m_head(&m_stub), m_tail(&m_stub)
+            {
+            }
+
+            ~IntrusiveMpscQueue()
+            {
+                while (Pop())
+                {
+                }
+            }
+
+            IntrusiveMpscQueue(const IntrusiveMpscQueue&) = delete;
+            IntrusiveMpscQueue& operator=(const IntrusiveMpscQueue&) = delete;
+
+            void Push(std::unique_ptr<T> element)
+            {
+                PushNode(element.release());
+            }
+
+            std::unique_ptr<T> Pop()
+            {
+                MpscNode* tail = m_tail;
+                MpscNode* next = tail->next.load(std::memory_order_acquire);
+                if (tail == &m_stub)
+                {
+                    if (next == nullptr)
+                    {
+                        return nullptr;
+                    }
+                    m_tail = next;
+                    tail = next;
+                    next = next->next.load(std::memory_order_acquire);
+                }
+
+                if (next != nullptr)
+                {
+                    m_tail = next;
+                    return std::unique_ptr<T>(static_cast<T*>(tail));
+                }
+
+                if (tail != m_head.load(std::memory_order_acquire))
+                {
+                    // A producer has swapped the head but not linked its node yet
+                    return nullptr;
+                }
+
+                // `tail` is the last node: put the stub behind it so it can be detached
+                PushNode(&m_stub);
+                next = tail->next.load(std::memory_order_acquire);
+                if (next != nullptr)
+                {
+                    m_tail = next;
+                    return std::unique_ptr<T>(static_cast<T*>(tail));
+                }
+                return nullptr;
+            }
+
+            // True when nothing has been pushed since the last element was popped. A push that is
+            // still linking counts as non-empty.
+            bool Empty() const
+            {
+                return m_tail == &m_stub && m_head.load(std::memory_order_acquire) == &m_stub;
+            }
+
+        private:
+            void PushNode(MpscNode* node)
+            {
+                node->next.store(nullptr, std::memory_order_relaxed);
+                MpscNode* previous = m_head.exchange(node, std::memory_order_acq_rel);
+                previous->next.store(node, std::memory_order_release);
+            }
+
+            std::atomic<MpscNode*> m_head;  // Most recently pushed node; producers
+            MpscNode* m_tail;               // Next node to pop; consumer only
+            MpscNode m_stub;
+        };
+    }
+}
@@ -0,0 +1,105 @@
+#include "pch.h"
+#include "IoContextPool.h"
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        IoContextPool::IoContextPool(size_t poolSize, std::chrono::microseconds busyPollWindow)
+            : m_busyPollWindow(busyPollWindow)
+        {
+            if (poolSize == 0)
+            {
+                throw std::invalid_argument("IoContextPool size must be greater than 0");
+            }
+
+            m_contexts.reserve(poolSize);
+            m_workGuards.reserve(poolSize);
+            for (size_t i = 0; i < poolSize; ++i)
+            {
+                m_contexts.push_back(std::make_unique<asio::io_context>(1));
+                m_workGuards.push_back(asio::make_work_guard(*m_contexts.back()));
+            }
+        }
+
+        IoContextPool::~IoContextPool()
+        {
+            Stop();
+            Join();
+        }
+
+        void IoContextPool::Run()
+        {
+            for (size_t i = 0; i < m_contexts.size(); ++i)
+            {
+                m_threads.emplace_back([context = m_contexts[i].get(), window = m_busyPollWindow]()
+                {
+                    if (window.count() > 0)
+                    {
+                        RunBusyPoll(*context, window);
+                    }
+                    else
+                    {
+                        context->run();
+                    }
+                });
+                LOG_INFO("IoContextPool: I/O thread {} started{}.", i + 1,
+                         m_busyPollWindow.count() > 0 ? fmt::format(" (busy-poll {}us)", m_busyPollWindow.count()) : "");
+            }
+        }
+
+        void IoContextPool::RunBusyPoll(asio::io_context& context, std::chrono::microseconds window)
+        {
+            using Clock = std::chrono::steady_clock;
+            while (!context.stopped())
+            {
+                // poll() runs ready handlers and checks the reactor with a zero timeout
+                auto idleSince = Clock::now();
+                while (Clock::now() - idleSince < window)
+                {
+                    if (context.poll() > 0)
+                    {
+                        idleSince = Clock::now();
+                    }
+                    else if (context.stopped())
+                    {
+                        return;
+                    }
+                }
+
+                // Nothing ready for a whole window: sleep in the reactor until the next handler
+                context.run_one();
+            }
+        }
+
+        void IoContextPool::Stop()
+        {
+            for (auto& guard : m_workGuards)
+            {
+                guard.reset();
+            }
+            for (auto& context : m_contexts)
+            {
+                context->stop();
+            }
+        }
+
+        void IoContextPool::Join()
+        {
+            for (std::thread& thread : m_threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+            m_threads.clear();
+        }
+
+        asio::io_context& IoContextPool::GetNextContext()
+        {
+            size_t index = m_nextContext.fetch_add(1, std::memory_order_relaxed) % m_contexts.size();
+            return *m_contexts[index];
+        }
+    }
+}
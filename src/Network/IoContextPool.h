@@ -0,0 +1,54 @@
+#pragma once
+#include "pch.h"
+
+namespace asio = boost::asio;
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        /**
+         * @brief Fixed set of single-threaded io_contexts, one per network I/O thread.
+         *
+         * Each context is run by exactly one thread and created with a concurrency hint of 1, so its
+         * reactor and completion handlers never migrate between cores. Sockets opened on a context
+         * stay on it for their whole lifetime.
+         *
+         * With a non-zero busy-poll window each thread polls its context without blocking and only
+         * falls back to a blocking run_one() after a full window with nothing ready. This trades a
+         * core per thread for skipping the reactor sleep/wakeup on every packet.
+         */
+        class IoContextPool
+        {
+        public:
+            explicit IoContextPool(size_t poolSize, std::chrono::microseconds busyPollWindow = std::chrono::microseconds::zero());
+            ~IoContextPool();
+
+            IoContextPool(const IoContextPool&) = delete;
+            IoContextPool& operator=(const IoContextPool&) = delete;
+
+            // Starts one thread per context.
+            void Run();
+            // Stops every context without waiting; safe to call from any thread.
+            void Stop();
+            // Joins the I/O threads. Must not be called from one of them.
+            void Join();
+
+            // Round-robin pick used to spread accepted sessions.
+            asio::io_context& GetNextContext();
+            asio::io_context& GetContext(size_t index) { return *m_contexts[index]; }
+            size_t Size() const { return m_contexts.size(); }
+
+        private:
+            using WorkGuard = asio::executor_work_guard<asio::io_context::executor_type>;
+
+            static void RunBusyPoll(asio::io_context& context, std::chrono::microseconds window);
+
+            std::vector<std::unique_ptr<asio::io_context>> m_contexts;
+            std::vector<WorkGuard> m_workGuards;
+            std::vector<std::thread> m_threads;
+            std::atomic<size_t> m_nextContext{0};
+            std::chrono::microseconds m_busyPollWindow;
+        };
+    }
+}
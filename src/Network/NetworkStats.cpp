@@ -0,0 +1,126 @@
+#include "pch.h"
+#include "NetworkStats.h"
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        NetworkStats& NetworkStats::Instance()
+        {
+            static NetworkStats instance;
+            return instance;
+        }
+
+        NetworkStats::NetworkStats()
+            : m_lastCollectTime(std::chrono::steady_clock::now())
+        {
+        }
+
+        NetworkStats::Snapshot NetworkStats::Collect()
+        {
+            std::lock_guard<std::mutex> lock(m_collectMutex);
+
+            auto now = std::chrono::steady_clock::now();
+            Snapshot snapshot;
+            snapshot.elapsedSeconds = std::chrono::duration<double>(now - m_lastCollectTime).count();
+            m_lastCollectTime = now;
+
+            snapshot.writeCalls = m_writeCalls.exchange(0, std::memory_order_relaxed);
+            snapshot.writeBuffers = m_writeBuffers.exchange(0, std::memory_order_relaxed);
+            snapshot.writeBytes = m_writeBytes.exchange(0, std::memory_order_relaxed);
+            snapshot.maxSessionQueuedBytes = m_maxSessionQueuedBytes.exchange(0, std::memory_order_relaxed);
+            snapshot.droppedSnapshots = m_droppedSnapshots.exchange(0, std::memory_order_relaxed);
+            snapshot.slowConsumerDisconnects = m_slowConsumerDisconnects.exchange(0, std::memory_order_relaxed);
+            snapshot.reapedIdle = m_reapedIdle.exchange(0, std::memory_order_relaxed);
+            snapshot.reapedStalled = m_reapedStalled.exchange(0, std::memory_order_relaxed);
+            snapshot.udpDatagrams = m_udpDatagrams.exchange(0, std::memory_order_relaxed);
+            snapshot.udpSendCalls = m_udpSendCalls.exchange(0, std::memory_order_relaxed);
+            snapshot.udpBytes = m_udpBytes.exchange(0, std::memory_order_relaxed);
+            snapshot.udpDropped = m_udpDropped.exchange(0, std::memory_order_relaxed);
+            snapshot.compressedBatches = m_compressedBatches.exchange(0, std::memory_order_relaxed);
+            snapshot.compressionInputBytes = m_compressionInputBytes.exchange(0, std::memory_order_relaxed);
+            snapshot.compressionOutputBytes = m_compressionOutputBytes.exchange(0, std::memory_order_relaxed);
+            snapshot.compressionNanos = m_compressionNanos.exchange(0, std::memory_order_relaxed);
+            snapshot.mailboxPosts = m_mailboxPosts.exchange(0, std::memory_order_relaxed);
+            snapshot.mailboxBatches = m_mailboxBatches.exchange(0, std::memory_order_relaxed);
+            snapshot.zeroCopyWrites = m_zeroCopyWrites.exchange(0, std::memory_order_relaxed);
+            snapshot.zeroCopyBytes = m_zeroCopyBytes.exchange(0, std::memory_order_relaxed);
+            snapshot.zeroCopyCompletions = m_zeroCopyCompletions.exchange(0, std::memory_order_relaxed);
+            snapshot.zeroCopyCopied = m_zeroCopyCopied.exchange(0, std::memory_order_relaxed);
+            for (size_t i = 0; i < m_ingressDroppedPackets.size(); ++i)
+            {
+                snapshot.ingressDroppedPackets[i] = m_ingressDroppedPackets[i].exchange(0, std::memory_order_relaxed);
+            }
+            snapshot.ingressDroppedBytes = m_ingressDroppedBytes.exchange(0, std::memory_order_relaxed);
+            for (size_t i = 0; i < m_admissions.size(); ++i)
+            {
+                snapshot.admissions[i] = m_admissions[i].exchange(0, std::memory_order_relaxed);
+            }
+            snapshot.jobsDispatched = m_jobsDispatched.exchange(0, std::memory_order_relaxed);
+            snapshot.jobsStolen = m_jobsStolen.exchange(0, std::memory_order_relaxed);
+            snapshot.jobOrderViolations = m_jobOrderViolations.exchange(0, std::memory_order_relaxed);
+            snapshot.inlineDispatched = m_inlineDispatched.exchange(0, std::memory_order_relaxed);
+            return snapshot;
+        }
+
+        void NetworkStats::Report(const Snapshot& snapshot, uint64_t ticks)
+        {
+            LOG_INFO("  Network Write - Writes/sec: {:.1f}, Avg buffers/write: {:.2f}, Bytes: {}",
+                    snapshot.WritesPerSecond(), snapshot.AvgBuffersPerWrite(), snapshot.writeBytes);
+            LOG_INFO("  Send Queue - Max session queued: {} bytes, Dropped snapshots: {}, Slow consumer disconnects: {}",
+                    snapshot.maxSessionQueuedBytes, snapshot.droppedSnapshots, snapshot.slowConsumerDisconnects);
+            LOG_INFO("  Reaper - Idle sessions closed: {}, Stalled sessions closed: {}",
+                    snapshot.reapedIdle, snapshot.reapedStalled);
+            if (snapshot.udpSendCalls > 0)
+            {
+                LOG_INFO("  UDP Snapshots - Datagrams: {} in {} sendmmsg calls, Bytes: {}, Dropped: {}",
+                        snapshot.udpDatagrams, snapshot.udpSendCalls, snapshot.udpBytes, snapshot.udpDropped);
+            }
+            if (snapshot.zeroCopyWrites > 0 || snapshot.zeroCopyCompletions > 0)
+            {
+                LOG_INFO("  Zero-copy - Writes: {}, Bytes: {}, Completions: {} (kernel copied {})",
+                        snapshot.zeroCopyWrites, snapshot.zeroCopyBytes, snapshot.zeroCopyCompletions, snapshot.zeroCopyCopied);
+            }
+            if (snapshot.mailboxPosts > 0)
+            {
+                double postsPerTick = ticks > 0 ? static_cast<double>(snapshot.mailboxPosts) / ticks : 0.0;
+                LOG_INFO("  Tick Flush - Cross-thread posts/tick: {:.1f}, Session batches per post: {:.1f}",
+                        postsPerTick, static_cast<double>(snapshot.mailboxBatches) / snapshot.mailboxPosts);
+            }
+            if (snapshot.ingressDroppedBytes > 0)
+            {
+                LOG_INFO("  Ingress Limit - Dropped packets: input {}, chat {}, control {}, Bytes: {}",
+                        snapshot.ingressDroppedPackets[static_cast<size_t>(IngressClass::Input)],
+                        snapshot.ingressDroppedPackets[static_cast<size_t>(IngressClass::Chat)],
+                        snapshot.ingressDroppedPackets[static_cast<size_t>(IngressClass::Control)],
+                        snapshot.ingressDroppedBytes);
+            }
+            uint64_t rejected = 0;
+            for (size_t i = static_cast<size_t>(AdmissionResult::Admitted) + 1; i < snapshot.admissions.size(); ++i)
+            {
+                rejected += snapshot.admissions[i];
+            }
+            if (rejected > 0)
+            {
+                auto count = [&snapshot](AdmissionResult result) { return snapshot.admissions[static_cast<size_t>(result)]; };
+                LOG_INFO("  Admission - Accepted: {}, Rejected: global rate {}, per-IP sessions {}, per-IP rate {}, capacity {}",
+                        count(AdmissionResult::Admitted), count(AdmissionResult::GlobalRate), count(AdmissionResult::IpConcurrent),
+                        count(AdmissionResult::IpRate), count(AdmissionResult::Capacity));
+            }
+            if (snapshot.jobsDispatched > 0 || snapshot.inlineDispatched > 0)
+            {
+                double jobsPerSecond = snapshot.elapsedSeconds > 0.0 ? snapshot.jobsDispatched / snapshot.elapsedSeconds : 0.0;
+                double inlinePerSecond = snapshot.elapsedSeconds > 0.0 ? snapshot.inlineDispatched / snapshot.elapsedSeconds : 0.0;
+                LOG_INFO("  Packet Workers - Jobs/sec: {:.1f}, Stolen: {}, Out-of-order dispatches: {}, Inline on I/O threads/sec: {:.1f}",
+                        jobsPerSecond, snapshot.jobsStolen, snapshot.jobOrderViolations, inlinePerSecond);
+            }
+            if (snapshot.compressedBatches > 0)
+            {
+                double cpuUsPerTick = ticks > 0 ? snapshot.compressionNanos / 1000.0 / ticks : 0.0;
+                LOG_INFO("  Compression - Batches: {}, Bytes: {} -> {} (ratio {:.2f}), CPU: {:.1f}μs/tick",
+                        snapshot.compressedBatches, snapshot.compressionInputBytes, snapshot.compressionOutputBytes,
+                        snapshot.CompressionRatio(), cpuUsPerTick);
+            }
+        }
+    }
+}
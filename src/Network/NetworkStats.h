@@ -0,0 +1,206 @@
+#pragma once
+#include "pch.h"
+#include "IService.h"
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        /**
+         * @brief Process-wide network I/O counters shared by all sessions.
+         *
+         * Sessions bump the relaxed atomics on their I/O threads; the game loop periodically calls
+         * Collect() to read and reset them for the performance report.
+         */
+        class NetworkStats
+        {
+        public:
+            struct Snapshot
+            {
+                double elapsedSeconds = 0.0;
+
+                // Outbound write path
+                uint64_t writeCalls = 0;
+                uint64_t writeBuffers = 0;
+                uint64_t writeBytes = 0;
+
+                // Outbound queue budget
+                uint64_t maxSessionQueuedBytes = 0;
+                uint64_t droppedSnapshots = 0;
+                uint64_t slowConsumerDisconnects = 0;
+
+                // Dead-connection reaper
+                uint64_t reapedIdle = 0;
+                uint64_t reapedStalled = 0;
+
+                // UDP snapshot channel
+                uint64_t udpDatagrams = 0;
+                uint64_t udpSendCalls = 0;
+                uint64_t udpBytes = 0;
+                uint64_t udpDropped = 0;
+
+                // LZ4 batch compression (input counts every batch that was tried)
+                uint64_t compressedBatches = 0;
+                uint64_t compressionInputBytes = 0;
+                uint64_t compressionOutputBytes = 0;
+                uint64_t compressionNanos = 0;
+
+                // Per-tick outbound mailboxes
+                uint64_t mailboxPosts = 0;
+                uint64_t mailboxBatches = 0;
+
+                // MSG_ZEROCOPY writes and their completion notifications
+                uint64_t zeroCopyWrites = 0;
+                uint64_t zeroCopyBytes = 0;
+                uint64_t zeroCopyCompletions = 0;
+                uint64_t zeroCopyCopied = 0;     // Completions where the kernel fell back to copying
+
+                // Ingress rate limiting, indexed by IngressClass
+                std::array<uint64_t, static_cast<size_t>(IngressClass::Count)> ingressDroppedPackets{};
+                uint64_t ingressDroppedBytes = 0;
+
+                // Connections closed at accept, indexed by AdmissionResult (Admitted counts accepted ones)
+                std::array<uint64_t, static_cast<size_t>(AdmissionResult::Count)> admissions{};
+
+                // JobProcessor packet workers
+                uint64_t jobsDispatched = 0;
+                uint64_t jobsStolen = 0;            // Taken from another worker's backed-up shard
+                uint64_t jobOrderViolations = 0;    // Dispatched after a later packet of the same session
+                uint64_t inlineDispatched = 0;      // Handled on the I/O thread without a job (PacketManager inline handlers)
+
+                double WritesPerSecond() const { return elapsedSeconds > 0.0 ? writeCalls / elapsedSeconds : 0.0; }
+                double AvgBuffersPerWrite() const { return writeCalls > 0 ? static_cast<double>(writeBuffers) / writeCalls : 0.0; }
+                double CompressionRatio() const { return compressionOutputBytes > 0 ? static_cast<double>(compressionInputBytes) / compressionOutputBytes : 0.0; }
+            };
+
+            static NetworkStats& Instance();
+
+            NetworkStats(const NetworkStats&) = delete;
+            NetworkStats& operator=(const NetworkStats&) = delete;
+
+            void RecordWrite(size_t bufferCount, size_t bytes)
+            {
+                m_writeCalls.fetch_add(1, std::memory_order_relaxed);
+                m_writeBuffers.fetch_add(bufferCount, std::memory_order_relaxed);
+                m_writeBytes.fetch_add(bytes, std::memory_order_relaxed);
+            }
+
+            // Tracks the largest per-session outbound queue seen in the current interval
+            void RecordQueuedBytes(size_t queuedBytes)
+            {
+                uint64_t current = m_maxSessionQueuedBytes.load(std::memory_order_relaxed);
+                while (queuedBytes > current &&
+                       !m_maxSessionQueuedBytes.compare_exchange_weak(current, queuedBytes, std::memory_order_relaxed))
+                {
+                }
+            }
+
+            void RecordDroppedSnapshot() { m_droppedSnapshots.fetch_add(1, std::memory_order_relaxed); }
+            void RecordSlowConsumerDisconnect() { m_slowConsumerDisconnects.fetch_add(1, std::memory_order_relaxed); }
+            void RecordReapedIdle() { m_reapedIdle.fetch_add(1, std::memory_order_relaxed); }
+            void RecordReapedStalled() { m_reapedStalled.fetch_add(1, std::memory_order_relaxed); }
+
+            void RecordUdpSend(size_t datagrams, size_t sendCalls, size_t bytes, size_t dropped)
+            {
+                m_udpDatagrams.fetch_add(datagrams, std::memory_order_relaxed);
+                m_udpSendCalls.fetch_add(sendCalls, std::memory_order_relaxed);
+                m_udpBytes.fetch_add(bytes, std::memory_order_relaxed);
+                m_udpDropped.fetch_add(dropped, std::memory_order_relaxed);
+            }
+
+            void RecordMailboxFlush(size_t posts, size_t batches)
+            {
+                m_mailboxPosts.fetch_add(posts, std::memory_order_relaxed);
+                m_mailboxBatches.fetch_add(batches, std::memory_order_relaxed);
+            }
+
+            void RecordZeroCopyWrite(size_t bytes)
+            {
+                m_zeroCopyWrites.fetch_add(1, std::memory_order_relaxed);
+                m_zeroCopyBytes.fetch_add(bytes, std::memory_order_relaxed);
+            }
+
+            void RecordZeroCopyCompletions(uint32_t completions, bool copied)
+            {
+                m_zeroCopyCompletions.fetch_add(completions, std::memory_order_relaxed);
+                if (copied)
+                {
+                    m_zeroCopyCopied.fetch_add(completions, std::memory_order_relaxed);
+                }
+            }
+
+            void RecordIngressDrop(IngressClass ingressClass, size_t bytes)
+            {
+                m_ingressDroppedPackets[static_cast<size_t>(ingressClass)].fetch_add(1, std::memory_order_relaxed);
+                m_ingressDroppedBytes.fetch_add(bytes, std::memory_order_relaxed);
+            }
+
+            void RecordAdmission(AdmissionResult result)
+            {
+                m_admissions[static_cast<size_t>(result)].fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void RecordJobDispatch(bool inOrder)
+            {
+                m_jobsDispatched.fetch_add(1, std::memory_order_relaxed);
+                if (!inOrder)
+                {
+                    m_jobOrderViolations.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            void RecordJobSteal() { m_jobsStolen.fetch_add(1, std::memory_order_relaxed); }
+            void RecordInlineDispatch() { m_inlineDispatched.fetch_add(1, std::memory_order_relaxed); }
+
+            void RecordCompression(size_t inputBytes, size_t outputBytes, int64_t nanos)
+            {
+                m_compressedBatches.fetch_add(1, std::memory_order_relaxed);
+                m_compressionInputBytes.fetch_add(inputBytes, std::memory_order_relaxed);
+                m_compressionOutputBytes.fetch_add(outputBytes, std::memory_order_relaxed);
+                m_compressionNanos.fetch_add(static_cast<uint64_t>(nanos), std::memory_order_relaxed);
+            }
+
+            // Returns the counters accumulated since the previous call and resets them.
+            Snapshot Collect();
+
+            // Logs a collected snapshot in the same format as the game loop performance report.
+            // `ticks` is the number of game ticks the snapshot covers, used for per-tick figures.
+            static void Report(const Snapshot& snapshot, uint64_t ticks = 0);
+
+        private:
+            NetworkStats();
+
+            std::atomic<uint64_t> m_writeCalls{0};
+            std::atomic<uint64_t> m_writeBuffers{0};
+            std::atomic<uint64_t> m_writeBytes{0};
+            std::atomic<uint64_t> m_maxSessionQueuedBytes{0};
+            std::atomic<uint64_t> m_droppedSnapshots{0};
+            std::atomic<uint64_t> m_slowConsumerDisconnects{0};
+            std::atomic<uint64_t> m_reapedIdle{0};
+            std::atomic<uint64_t> m_reapedStalled{0};
+            std::atomic<uint64_t> m_udpDatagrams{0};
+            std::atomic<uint64_t> m_udpSendCalls{0};
+            std::atomic<uint64_t> m_udpBytes{0};
+            std::atomic<uint64_t> m_udpDropped{0};
+            std::atomic<uint64_t> m_compressedBatches{0};
+            std::atomic<uint64_t> m_compressionInputBytes{0};
+            std::atomic<uint64_t> m_compressionOutputBytes{0};
+            std::atomic<uint64_t> m_compressionNanos{0};
+            std::atomic<uint64_t> m_mailboxPosts{0};
+            std::atomic<uint64_t> m_mailboxBatches{0};
+            std::atomic<uint64_t> m_zeroCopyWrites{0};
+            std::atomic<uint64_t> m_zeroCopyBytes{0};
+            std::atomic<uint64_t> m_zeroCopyCompletions{0};
+            std::atomic<uint64_t> m_zeroCopyCopied{0};
+            std::array<std::atomic<uint64_t>, static_cast<size_t>(IngressClass::Count)> m_ingressDroppedPackets{};
+            std::atomic<uint64_t> m_ingressDroppedBytes{0};
+            std::array<std::atomic<uint64_t>, static_cast<size_t>(AdmissionResult::Count)> m_admissions{};
+            std::atomic<uint64_t> m_jobsDispatched{0};
+            std::atomic<uint64_t> m_jobsStolen{0};
+            std::atomic<uint64_t> m_jobOrderViolations{0};
+            std::atomic<uint64_t> m_inlineDispatched{0};
+
+            std::mutex m_collectMutex;
+            std::chrono::steady_clock::time_point m_lastCollectTime;
+        };
+    }
+}
@@ -0,0 +1,80 @@
+#include "pch.h"
+#include "OutboundMailbox.h"
+#include "NetworkStats.h"
+
+namespace asio = boost::asio;
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        void OutboundMailbox::Stage(std::shared_ptr<ISession> session, std::vector<flatbuffers::DetachedBuffer> framedPackets)
+        {
+            if (!session || framedPackets.empty()) return;
+
+            auto executor = session->GetExecutor();
+            const asio::execution_context* context = &asio::query(executor, asio::execution::context);
+
+            auto& mailbox = m_mailboxes[context];
+            if (!mailbox.executor)
+            {
+                mailbox.executor = std::move(executor);
+            }
+            mailbox.deliveries.push_back(Delivery{std::move(session), std::move(framedPackets)});
+        }
+
+        void OutboundMailbox::Flush()
+        {
+            size_t posts = 0;
+            size_t batches = 0;
+
+            for (auto& [context, mailbox] : m_mailboxes)
+            {
+                if (mailbox.deliveries.empty()) continue;
+
+                size_t count = mailbox.deliveries.size();
+                size_t tasks = std::min(m_threadsPerContext, count);
+                batches += count;
+                posts += tasks;
+
+                if (tasks == 1)
+                {
+                    asio::post(mailbox.executor, [deliveries = std::move(mailbox.deliveries)]() mutable
+                    {
+                        Deliver(deliveries);
+                    });
+                }
+                else
+                {
+                    // Shared context: one contiguous slice per thread, so every I/O thread takes a share
+                    for (size_t task = 0; task < tasks; ++task)
+                    {
+                        auto first = mailbox.deliveries.begin() + count * task / tasks;
+                        auto last = mailbox.deliveries.begin() + count * (task + 1) / tasks;
+                        std::vector<Delivery> slice(std::make_move_iterator(first), std::make_move_iterator(last));
+                        asio::post(mailbox.executor, [deliveries = std::move(slice)]() mutable
+                        {
+                            Deliver(deliveries);
+                        });
+                    }
+                }
+                mailbox.deliveries.clear();
+            }
+
+            if (posts > 0)
+            {
+                NetworkStats::Instance().RecordMailboxFlush(posts, batches);
+            }
+        }
+
+        void OutboundMailbox::Deliver(std::vector<Delivery>& deliveries)
+        {
+            for (auto& delivery : deliveries)
+            {
+                if (!delivery.session->IsConnected()) continue;
+
+                delivery.session->SendBatch(std::move(delivery.framedPackets));
+            }
+        }
+    }
+}
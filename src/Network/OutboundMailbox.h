@@ -0,0 +1,59 @@
+#pragma once
+#include "pch.h"
+#include "ISession.h"
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        /**
+         * @brief Per-tick outbound mailboxes, one per I/O execution context.
+         *
+         * The game loop stages every session's snapshot batch in the mailbox of the context that
+         * owns the session, then Flush() posts one task per I/O thread of that context. Each task
+         * hands its share of the batches to the sessions on their own thread, so waking the writers
+         * is a local operation and the game thread issues O(io threads) cross-thread notifications
+         * per tick instead of O(players). In per-core mode that is one task per context; with one
+         * shared context the batches are split across its threads, so SendBatch (and its LZ4
+         * compression) does not pile up on whichever thread runs the single task.
+         *
+         * Stage() and Flush() must be called from the same (game loop) thread.
+         */
+        class OutboundMailbox
+        {
+        public:
+            OutboundMailbox() = default;
+
+            OutboundMailbox(const OutboundMailbox&) = delete;
+            OutboundMailbox& operator=(const OutboundMailbox&) = delete;
+
+            // Takes the session's size-prefixed packets for this tick; they are sent as one batch.
+            void Stage(std::shared_ptr<ISession> session, std::vector<flatbuffers::DetachedBuffer> framedPackets);
+
+            // Posts up to threadsPerContext delivery tasks per context that has staged batches.
+            void Flush();
+
+            // Threads running each I/O context: worker_threads for the shared context, 1 per-core
+            void SetThreadsPerContext(size_t threads) { m_threadsPerContext = std::max<size_t>(1, threads); }
+
+        private:
+            struct Delivery
+            {
+                std::shared_ptr<ISession> session;
+                std::vector<flatbuffers::DetachedBuffer> framedPackets;
+            };
+
+            struct Mailbox
+            {
+                boost::asio::any_io_executor executor;
+                std::vector<Delivery> deliveries;
+            };
+
+            static void Deliver(std::vector<Delivery>& deliveries);
+
+            // Keyed by the session executor's execution context
+            std::unordered_map<const boost::asio::execution_context*, Mailbox> m_mailboxes;
+            size_t m_threadsPerContext = 1;
+        };
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "pch.h"
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        /**
+         * @brief Immutable, already-framed packet that can be queued on many sessions at once.
+         *
+         * Holds the 4-byte little-endian length header followed by the packet body. The bytes are
+         * written once at creation and never modified, so one instance can be shared by reference
+         * between the write queues of every recipient of a broadcast.
+         *
+         * A FlatBuffers buffer finished with `FinishSizePrefixed` already has exactly this layout
+         * (the prefix is a little-endian uoffset_t), so its detached buffer is adopted as-is.
+         */
+        class PacketBuffer
+        {
+        public:
+            /**
+             * @brief Frames the given body into a new shared buffer.
+             * @param body Serialized packet body (without length header).
+             */
+            static std::shared_ptr<const PacketBuffer> Create(std::span<const std::byte> body)
+            {
+                return std::make_shared<const PacketBuffer>(body);
+            }
+
+            /**
+             * @brief Adopts a size-prefixed FlatBuffers buffer without copying it.
+             * @param framed Result of `builder.Release()` after `builder.FinishSizePrefixed(...)`.
+             */
+            static std::shared_ptr<const PacketBuffer> Create(flatbuffers::DetachedBuffer framed)
+            {
+                return std::make_shared<const PacketBuffer>(std::move(framed));
+            }
+
+            explicit PacketBuffer(std::span<const std::byte> body)
+            {
+                uint32_t bodyLength = static_cast<uint32_t>(body.size());
+                m_bytes.reserve(sizeof(uint32_t) + body.size());
+                m_bytes.insert(m_bytes.end(),
+                               reinterpret_cast<const std::byte*>(&bodyLength),
+                               reinterpret_cast<const std::byte*>(&bodyLength) + sizeof(uint32_t));
+                m_bytes.insert(m_bytes.end(), body.begin(), body.end());
+            }
+
+            explicit PacketBuffer(flatbuffers::DetachedBuffer framed)
+                : m_framed(std::move(framed))
+            {
+            }
+
+            PacketBuffer(const PacketBuffer&) = delete;
+            PacketBuffer& operator=(const PacketBuffer&) = delete;
+
+            // Framed bytes (header + body) ready to be written to the socket.
+            std::span<const std::byte> Bytes() const
+            {
+                if (m_framed.size() > 0)
+                {
+                    return std::span<const std::byte>(reinterpret_cast<const std::byte*>(m_framed.data()), m_framed.size());
+                }
+                return m_bytes;
+            }
+            size_t Size() const { return Bytes().size(); }
+
+        private:
+            std::vector<std::byte> m_bytes;
+            flatbuffers::DetachedBuffer m_framed;
+        };
+
+        using SharedPacket = std::shared_ptr<const PacketBuffer>;
+    }
+}
@@ -2,6 +2,9 @@
 #include "PacketManager.h"
 #include "Utils/JobProcessor.h"
 #include "Utils/JobQueue.h"
+#include "Utils/MemoryPool.h"
+#include "IngressLimiter.h"
+#include "NetworkStats.h"
 
 namespace asio = boost::asio;
 namespace ip = boost::asio::ip;
@@ -10,8 +13,8 @@ namespace CppMMO
 {
     namespace Network
     {
-        PacketManager::PacketManager(std::shared_ptr<Utils::JobQueue> jobQueue)
-            : m_jobQueue(std::move(jobQueue))
+        PacketManager::PacketManager(std::shared_ptr<Utils::JobQueue> jobQueue, size_t inlineMaxBytes)
+            : m_jobQueue(std::move(jobQueue)), m_inlineMaxBytes(inlineMaxBytes)
         {
         }
         
@@ -32,13 +35,50 @@ namespace CppMMO
             LOG_INFO("Handler unregistered for PacketId: {}", static_cast<int>(id));
         }
 
-        void PacketManager::HandlePacket(const std::shared_ptr<ISession>& session, const std::vector<std::byte>& packet)
+        void PacketManager::RegisterInlineHandler(PacketId id, const PacketHandler& handler)
         {
+            if(!handler)
+            {
+                throw std::invalid_argument("Attempted to register a null inline PacketHandler for PacketId: " + std::to_string(static_cast<int>(id)));
+            }
+            m_inlineHandlers.emplace(id, handler);
+            LOG_INFO("Inline handler registered for PacketId: {}", static_cast<int>(id));
+        }
+
+        void PacketManager::HandlePacket(const std::shared_ptr<ISession>& session, std::span<const std::byte> packet)
+        {
+            if (!m_inlineHandlers.empty() && packet.size() <= m_inlineMaxBytes)
+            {
+                // The bounds-checked id peek picks candidates; only those pay for full verification here
+                auto id = IngressLimiter::PeekPacketId(packet);
+                auto it = id ? m_inlineHandlers.find(static_cast<PacketId>(*id)) : m_inlineHandlers.end();
+                if (it != m_inlineHandlers.end())
+                {
+                    const auto* bytes = reinterpret_cast<const uint8_t*>(packet.data());
+                    flatbuffers::Verifier verifier(bytes, packet.size());
+                    if (!Protocol::VerifyUnifiedPacketBuffer(verifier))
+                    {
+                        LOG_ERROR("Received invalid FlatBuffers UnifiedPacket on I/O thread. Buffer size: {}, Session: {}",
+                                 packet.size(), session->GetSessionId());
+                        return;
+                    }
+                    // No job sequence: the packet skips the queue by design, and stamping it would make
+                    // every job queued behind it look out of order
+                    NetworkStats::Instance().RecordInlineDispatch();
+                    it->second(session, Protocol::GetUnifiedPacket(bytes));
+                    return;
+                }
+            }
+
             if (m_jobQueue)
             {
-                // Create a copy to move (avoid const reference issue)
-                std::vector<std::byte> packetCopy = packet;
-                m_jobQueue->PushJob(Utils::Job(session, std::move(packetCopy)));
+                // The span points into the session's receive buffer; copy it into a pooled slab
+                // whose ownership moves with the job and is returned after dispatch
+                auto pooledPacket = Utils::MemoryPoolManager::Instance().GetPacketSlabPool().Acquire(packet);
+                Utils::Job job(session, std::move(pooledPacket));
+                job.sequence = session->NextPacketSequence();
+                job.receivedAtUs = Game::GetSteadyMicros();
+                m_jobQueue->PushJob(std::move(job));
             }
             else
             {
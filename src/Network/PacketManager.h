@@ -15,16 +15,20 @@ namespace CppMMO
         class PacketManager : public IPacketManager
         {
         public:
-            explicit PacketManager(std::shared_ptr<Utils::JobQueue> jobQueue);
+            // `inlineMaxBytes` caps the packets considered for inline handlers
+            explicit PacketManager(std::shared_ptr<Utils::JobQueue> jobQueue, size_t inlineMaxBytes = 256);
             virtual ~PacketManager() = default;
             
             virtual void RegisterHandler(PacketId id, const PacketHandler& handler) override;
             virtual void UnregisterHandler(PacketId id) noexcept override;
-            virtual void HandlePacket(const std::shared_ptr<ISession>& session, const std::vector<std::byte>& packet) override;
+            virtual void RegisterInlineHandler(PacketId id, const PacketHandler& handler) override;
+            virtual void HandlePacket(const std::shared_ptr<ISession>& session, std::span<const std::byte> packet) override;
             virtual void DispatchPacket(Protocol::PacketId id, const std::shared_ptr<ISession>& session, const Protocol::UnifiedPacket* packet) override;
         private:
             std::unordered_map<PacketId, PacketHandler> m_handlers{};
+            std::unordered_map<PacketId, PacketHandler> m_inlineHandlers{};
             std::shared_ptr<Utils::JobQueue> m_jobQueue;
+            size_t m_inlineMaxBytes;
         };
     }
 }
\ No newline at end of file
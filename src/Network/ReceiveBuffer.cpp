@@ -0,0 +1,117 @@
+#include "pch.h"
+#include "ReceiveBuffer.h"
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        ReceiveBuffer::ReceiveBuffer(size_t initialCapacity)
+            : m_storage(initialCapacity)
+        {
+        }
+
+        std::span<std::byte> ReceiveBuffer::PrepareWrite(size_t minFree)
+        {
+            if (Capacity() - m_writePos < minFree)
+            {
+                // Move unread bytes to the front before considering a resize
+                size_t unread = m_writePos - m_readPos;
+                if (m_readPos > 0)
+                {
+                    std::memmove(Data(), Data() + m_readPos, unread);
+                    m_readPos = 0;
+                    m_writePos = unread;
+                }
+                if (Capacity() - m_writePos < minFree)
+                {
+                    if (m_usingFixed)
+                    {
+                        MoveToOwnedStorage(m_writePos + minFree);
+                    }
+                    else
+                    {
+                        m_storage.resize(m_writePos + minFree);
+                    }
+                }
+            }
+            return std::span<std::byte>(Data() + m_writePos, Capacity() - m_writePos);
+        }
+
+        void ReceiveBuffer::Consume(size_t bytes)
+        {
+            m_readPos += bytes;
+            if (m_readPos == m_writePos)
+            {
+                // Buffer drained: restart at the front so the next read gets the full capacity
+                m_readPos = 0;
+                m_writePos = 0;
+                if (!m_usingFixed && !m_fixedStorage.empty())
+                {
+                    // The oversized frame is done; go back to the fixed region
+                    m_usingFixed = true;
+                    m_storage.clear();
+                    m_storage.shrink_to_fit();
+                }
+            }
+        }
+
+        void ReceiveBuffer::EnsureCapacity(size_t frameSize)
+        {
+            if (Capacity() < frameSize)
+            {
+                if (m_usingFixed)
+                {
+                    MoveToOwnedStorage(frameSize);
+                }
+                else
+                {
+                    m_storage.resize(frameSize);
+                }
+            }
+        }
+
+        void ReceiveBuffer::AttachFixedStorage(std::span<std::byte> storage)
+        {
+            m_fixedStorage = storage;
+            m_usingFixed = !storage.empty();
+            if (m_usingFixed)
+            {
+                m_storage.clear();
+                m_storage.shrink_to_fit();
+            }
+            m_readPos = 0;
+            m_writePos = 0;
+        }
+
+        void ReceiveBuffer::ReleaseIfDrained()
+        {
+            if (m_readPos == m_writePos && !m_usingFixed && m_fixedStorage.empty() && m_storage.capacity() > 0)
+            {
+                m_storage.clear();
+                m_storage.shrink_to_fit();
+                m_readPos = 0;
+                m_writePos = 0;
+            }
+        }
+
+        void ReceiveBuffer::MoveToOwnedStorage(size_t capacity)
+        {
+            size_t unread = m_writePos - m_readPos;
+            m_storage.resize(std::max(capacity, unread));
+            std::memcpy(m_storage.data(), m_fixedStorage.data() + m_readPos, unread);
+            m_usingFixed = false;
+            m_readPos = 0;
+            m_writePos = unread;
+        }
+
+        void ReceiveBuffer::Release()
+        {
+            m_storage.clear();
+            m_storage.shrink_to_fit();
+            m_fixedStorage = {};
+            m_usingFixed = false;
+            m_readPos = 0;
+            m_writePos = 0;
+        }
+    }
+}
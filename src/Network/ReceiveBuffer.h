@@ -0,0 +1,65 @@
+#pragma once
+#include "pch.h"
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        /**
+         * @brief Per-session receive buffer for length-prefixed frames.
+         *
+         * Bytes are appended at the write cursor by `async_read_some` and consumed from the read
+         * cursor as complete frames are parsed. Instead of wrapping around, the unread tail is moved
+         * back to the front when more space is needed, so every frame stays contiguous and can be
+         * handed to the FlatBuffers verifier without an extra copy.
+         *
+         * Storage is either an owned vector or a fixed external region (a registered io_uring
+         * chunk). A frame that does not fit the fixed region moves the data to the vector; the
+         * buffer switches back to the fixed region once it drains.
+         *
+         * Owned storage is allocated on first use, so a buffer that never holds data costs nothing.
+         */
+        class ReceiveBuffer
+        {
+        public:
+            explicit ReceiveBuffer(size_t initialCapacity = 0);
+
+            /**
+             * @brief Returns writable space at the end of the buffer.
+             *
+             * Compacts or grows the storage so that at least `minFree` bytes are available.
+             */
+            std::span<std::byte> PrepareWrite(size_t minFree);
+            void Commit(size_t bytes) { m_writePos += bytes; }
+
+            std::span<const std::byte> Readable() const
+            {
+                return std::span<const std::byte>(Data() + m_readPos, m_writePos - m_readPos);
+            }
+            void Consume(size_t bytes);
+
+            // Makes sure a frame of `frameSize` bytes fits once the unread data is compacted.
+            void EnsureCapacity(size_t frameSize);
+
+            // Uses `storage` while frames fit in it; must be called while the buffer is empty.
+            void AttachFixedStorage(std::span<std::byte> storage);
+            bool UsingFixedStorage() const { return m_usingFixed; }
+
+            size_t Capacity() const { return m_usingFixed ? m_fixedStorage.size() : m_storage.size(); }
+            void Release();
+            // Frees owned storage when nothing is buffered; fixed storage is left attached.
+            void ReleaseIfDrained();
+
+        private:
+            std::byte* Data() { return m_usingFixed ? m_fixedStorage.data() : m_storage.data(); }
+            const std::byte* Data() const { return m_usingFixed ? m_fixedStorage.data() : m_storage.data(); }
+            void MoveToOwnedStorage(size_t capacity);
+
+            std::vector<std::byte> m_storage;
+            std::span<std::byte> m_fixedStorage;
+            bool m_usingFixed = false;
+            size_t m_readPos = 0;
+            size_t m_writePos = 0;
+        };
+    }
+}
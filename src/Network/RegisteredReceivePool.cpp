@@ -0,0 +1,79 @@
+#include "pch.h"
+#include "RegisteredReceivePool.h"
+
+#ifdef BOOST_ASIO_HAS_IO_URING
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        namespace
+        {
+            std::vector<asio::mutable_buffer> SliceArena(std::byte* arena, size_t chunkCount, size_t chunkSize)
+            {
+                std::vector<asio::mutable_buffer> chunks;
+                chunks.reserve(chunkCount);
+                for (size_t i = 0; i < chunkCount; ++i)
+                {
+                    chunks.emplace_back(arena + i * chunkSize, chunkSize);
+                }
+                return chunks;
+            }
+        }
+
+        RegisteredReceiveChunk::RegisteredReceiveChunk(RegisteredReceiveChunk&& other) noexcept
+            : m_pool(std::exchange(other.m_pool, nullptr)),
+              m_index(other.m_index),
+              m_buffer(other.m_buffer)
+        {
+        }
+
+        RegisteredReceiveChunk& RegisteredReceiveChunk::operator=(RegisteredReceiveChunk&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                m_pool = std::exchange(other.m_pool, nullptr);
+                m_index = other.m_index;
+                m_buffer = other.m_buffer;
+            }
+            return *this;
+        }
+
+        void RegisteredReceiveChunk::Reset()
+        {
+            if (m_pool)
+            {
+                m_pool->Release(m_index);
+                m_pool.reset();
+            }
+        }
+
+        RegisteredReceivePool::RegisteredReceivePool(asio::io_context& io_context, size_t chunkCount)
+            : m_ioContext(io_context),
+              m_arena(std::make_unique<std::byte[]>(chunkCount * CHUNK_SIZE)),
+              m_chunks(SliceArena(m_arena.get(), chunkCount, CHUNK_SIZE)),
+              m_registration(asio::register_buffers(io_context, m_chunks)),
+              m_freeChunks(chunkCount)
+        {
+            for (size_t i = 0; i < chunkCount; ++i)
+            {
+                m_freeChunks.enqueue(i);
+            }
+            LOG_INFO("RegisteredReceivePool initialized with {} chunks, {} bytes each", chunkCount, CHUNK_SIZE);
+        }
+
+        RegisteredReceiveChunk RegisteredReceivePool::Acquire()
+        {
+            size_t index = 0;
+            if (!m_freeChunks.try_dequeue(index))
+            {
+                m_misses.fetch_add(1, std::memory_order_relaxed);
+                return RegisteredReceiveChunk();
+            }
+            return RegisteredReceiveChunk(shared_from_this(), index, *(m_registration.begin() + index));
+        }
+    }
+}
+
+#endif // BOOST_ASIO_HAS_IO_URING
@@ -0,0 +1,88 @@
+#pragma once
+#include "pch.h"
+
+#ifdef BOOST_ASIO_HAS_IO_URING
+
+namespace asio = boost::asio;
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        class RegisteredReceivePool;
+
+        /**
+         * @brief Move-only handle to one registered receive chunk.
+         *
+         * Reads into `Buffer()` are submitted as fixed-buffer io_uring reads, so the kernel skips
+         * pinning and mapping the user pages on every call. Returned to the pool on destruction.
+         * Holds a reference to the pool: sessions kept by SessionManager or ChatManager can outlive
+         * the TcpServer that created the pools.
+         */
+        class RegisteredReceiveChunk
+        {
+        public:
+            RegisteredReceiveChunk() = default;
+            RegisteredReceiveChunk(std::shared_ptr<RegisteredReceivePool> pool, size_t index, asio::mutable_registered_buffer buffer)
+                : m_pool(std::move(pool)), m_index(index), m_buffer(buffer) {}
+            ~RegisteredReceiveChunk() { Reset(); }
+
+            RegisteredReceiveChunk(const RegisteredReceiveChunk&) = delete;
+            RegisteredReceiveChunk& operator=(const RegisteredReceiveChunk&) = delete;
+            RegisteredReceiveChunk(RegisteredReceiveChunk&& other) noexcept;
+            RegisteredReceiveChunk& operator=(RegisteredReceiveChunk&& other) noexcept;
+
+            explicit operator bool() const { return m_pool != nullptr; }
+
+            const asio::mutable_registered_buffer& Buffer() const { return m_buffer; }
+            std::span<std::byte> Bytes() const
+            {
+                return std::span<std::byte>(static_cast<std::byte*>(m_buffer.data()), m_buffer.size());
+            }
+
+            void Reset();
+
+        private:
+            std::shared_ptr<RegisteredReceivePool> m_pool;
+            size_t m_index = 0;
+            asio::mutable_registered_buffer m_buffer;
+        };
+
+        /**
+         * @brief Arena of equally sized receive chunks registered with one io_context's io_uring.
+         *
+         * Registration is per ring, so each io_context gets its own pool; a session takes a chunk
+         * from the pool of the context its socket lives on. Create with std::make_shared.
+         */
+        class RegisteredReceivePool : public std::enable_shared_from_this<RegisteredReceivePool>
+        {
+        public:
+            static constexpr size_t CHUNK_SIZE = 4096;
+
+            RegisteredReceivePool(asio::io_context& io_context, size_t chunkCount);
+
+            RegisteredReceivePool(const RegisteredReceivePool&) = delete;
+            RegisteredReceivePool& operator=(const RegisteredReceivePool&) = delete;
+
+            // Empty handle when every chunk is in use; the session then reads into heap memory.
+            RegisteredReceiveChunk Acquire();
+
+            asio::io_context& GetContext() const { return m_ioContext; }
+            size_t GetChunkCount() const { return m_chunks.size(); }
+            uint64_t GetMissCount() const { return m_misses.load(std::memory_order_relaxed); }
+
+        private:
+            friend class RegisteredReceiveChunk;
+            void Release(size_t index) { m_freeChunks.enqueue(index); }
+
+            asio::io_context& m_ioContext;
+            std::unique_ptr<std::byte[]> m_arena;
+            std::vector<asio::mutable_buffer> m_chunks;
+            asio::buffer_registration<std::vector<asio::mutable_buffer>> m_registration;
+            moodycamel::ConcurrentQueue<size_t> m_freeChunks;
+            std::atomic<uint64_t> m_misses{0};
+        };
+    }
+}
+
+#endif // BOOST_ASIO_HAS_IO_URING
@@ -1,67 +1,111 @@
 #include "pch.h"
 #include "Session.h"
+#include "NetworkStats.h"
+#include "FrameCompression.h"
+
+#ifdef __linux__
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <cerrno>
+#endif
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+#define CPPMMO_HAS_MSG_ZEROCOPY 1
+#endif
 
 namespace asio = boost::asio;
 namespace ip = boost::asio::ip;
 
 std::atomic<uint64_t> CppMMO::Network::Session::s_nextSessionId = 0;
 
+namespace
+{
+    const std::shared_ptr<const CppMMO::Network::SessionConfig>& DefaultSessionConfig()
+    {
+        static const auto config = std::make_shared<const CppMMO::Network::SessionConfig>();
+        return config;
+    }
+}
+
 namespace CppMMO
 {
     namespace Network
     {
-        Session::Session(ip::tcp::socket socket, std::shared_ptr<IPacketManager> packetManager) 
+        Session::Session(ip::tcp::socket socket, std::shared_ptr<IPacketManager> packetManager, std::shared_ptr<const SessionConfig> config) 
             : m_socket{std::move(socket)}, 
               m_packetManager{packetManager},
-              m_timer(m_socket.get_executor()),
-              m_sessionId(s_nextSessionId.fetch_add(1))
+              m_config(config ? std::move(config) : DefaultSessionConfig()),
+              m_sessionId(s_nextSessionId.fetch_add(1)),
+              m_lastReadMs(SteadyNowMs()),
+              m_ingressLimiter(m_config->ingress),
+              m_maxFrameBytes(static_cast<uint32_t>(m_config->ingress.max_frame_bytes > 0
+                  ? std::min<size_t>(m_config->ingress.max_frame_bytes, MAX_PACKET_BODY_SIZE)
+                  : MAX_PACKET_BODY_SIZE))
         {
-            LOG_INFO("Session {} created. Remote endpoint: {}", m_sessionId, m_socket.remote_endpoint().address().to_string());
+            // A peer that reset before setup leaves an unspecified endpoint; the read loop then reports the disconnect
+            boost::system::error_code ec;
+            m_remoteEndpoint = m_socket.remote_endpoint(ec);
+            LOG_INFO("Session {} created. Remote endpoint: {}", m_sessionId, m_remoteEndpoint.address().to_string());
         }
 
         ip::tcp::endpoint Session::GetRemoteEndpoint() const
         {
-            return m_socket.remote_endpoint();
+            return m_remoteEndpoint;
         }
 
         void Session::Start()
         {
             LOG_INFO("Session {} started.", m_sessionId);
-            asio::co_spawn(m_socket.get_executor(), [self = shared_from_this()]() -> asio::awaitable<void>
+
+            // ReadLoop reads synchronously after a readiness wait and must not block on a spurious wakeup
+            boost::system::error_code ec;
+            m_socket.non_blocking(true, ec);
+#ifdef SO_BUSY_POLL
+            if (m_config->socket_busy_poll_us > 0)
             {
-                return self->ReadLoop();
-            }, asio::detached);
+                int busyPollUs = m_config->socket_busy_poll_us;
+                if (::setsockopt(m_socket.native_handle(), SOL_SOCKET, SO_BUSY_POLL, &busyPollUs, sizeof(busyPollUs)) != 0)
+                {
+                    LOG_DEBUG("Session {}: SO_BUSY_POLL {}us rejected: {}", m_sessionId, busyPollUs, std::strerror(errno));
+                }
+            }
+#endif
+#ifdef CPPMMO_HAS_MSG_ZEROCOPY
+            if (m_config->zerocopy_threshold_bytes > 0)
+            {
+                int enable = 1;
+                m_zeroCopyEnabled = ::setsockopt(m_socket.native_handle(), SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) == 0;
+            }
+#endif
             asio::co_spawn(m_socket.get_executor(), [self = shared_from_this()]() -> asio::awaitable<void>
             {
-                return self->WriteLoop();
+                return self->ReadLoop();
             }, asio::detached);
+            // WriteLoop is started by the first Enqueue
         }
 
         void Session::Disconnect()
         {
+            if (m_handingOver.load(std::memory_order_acquire))
+            {
+                // The connection now belongs to the next process; closing it here would reset it
+                return;
+            }
+
             boost::system::error_code ec;
             
-            // 1. Cancel all async operations first
-            m_timer.cancel();
-            
-            // 2. Shutdown and close socket
+            // 1. Shutdown and close socket; a running WriteLoop fails its write and exits
             m_socket.shutdown(ip::tcp::socket::shutdown_both, ec);
             m_socket.close(ec);
             
-            // 3. Clear all buffers to prevent resource leaks
-            m_readHeader.fill(std::byte{0}); // Clear header buffer
-            m_readBody.clear();
-            m_readBody.shrink_to_fit(); // Release memory
+            // 2. Drop the parked snapshot. The write queue has a single consumer (WriteLoop), so
+            // anything still queued is freed with the session.
+            ReplacePendingSnapshot(std::nullopt);
             
-            // 4. Clear write queue to prevent pending writes
-            std::vector<std::byte> dummy;
-            while (m_writeQueue.try_dequeue(dummy)) {
-                // Drain the queue
-            }
-            
-            LOG_INFO("Session {} closed and all buffers cleared.", m_sessionId);
+            LOG_INFO("Session {} closed and all buffers cleared. Ingress dropped: {} packets, {} bytes",
+                     m_sessionId, m_ingressLimiter.GetDroppedPackets(), m_ingressLimiter.GetDroppedBytes());
 
-            if (m_onDisconnectedCallback)
+            if (m_onDisconnectedCallback && !m_disconnectNotified.exchange(true, std::memory_order_acq_rel))
             {
                 m_onDisconnectedCallback(shared_from_this());
             }
@@ -93,26 +137,42 @@ namespace CppMMO
             
             packetToSend.insert(packetToSend.end(), data.begin(), data.end());
 
-            m_writeQueue.enqueue(std::move(packetToSend));
-
-            m_timer.cancel_one();
+            Enqueue(OutboundPacket{std::move(packetToSend), nullptr, false});
             LOG_DEBUG("Session {}: Packet of total {} bytes (body {}) added to write queue.", m_sessionId, totalPacketLength, bodyLength);
         }
 
-        void Session::SendBatch(const std::vector<std::span<const std::byte>>& packets)
+        void Session::SendFramed(flatbuffers::DetachedBuffer packet)
         {
-            if (packets.empty()) return;
+            if (packet.size() <= sizeof(uint32_t)) return;
+
+            size_t packetSize = packet.size();
+            Enqueue(OutboundPacket{{}, nullptr, false, std::move(packet)});
+            LOG_DEBUG("Session {}: Framed packet of {} bytes added to write queue.", m_sessionId, packetSize);
+        }
+
+        void Session::SendShared(SharedPacket packet)
+        {
+            if (!packet) return;
+
+            size_t packetSize = packet->Size();
+            Enqueue(OutboundPacket{{}, std::move(packet), false});
+            LOG_DEBUG("Session {}: Shared packet of {} bytes added to write queue.", m_sessionId, packetSize);
+        }
+
+        void Session::SendBatch(std::vector<flatbuffers::DetachedBuffer> framedPackets)
+        {
+            if (framedPackets.empty()) return;
 
             // Calculate total size needed with overflow protection
             constexpr size_t MAX_BATCH_SIZE = 64 * 1024 * 1024; // 64MB limit
             size_t totalSize = 0;
-            for (const auto& packet : packets) {
+            for (const auto& packet : framedPackets) {
                 // Check for potential overflow
-                if (totalSize > SIZE_MAX - sizeof(uint32_t) - packet.size()) {
+                if (totalSize > SIZE_MAX - packet.size()) {
                     LOG_ERROR("Session {}: Batch size overflow, dropping batch", m_sessionId);
                     return;
                 }
-                totalSize += sizeof(uint32_t) + packet.size(); // header + body
+                totalSize += packet.size(); // already carries its length header
                 
                 // Check practical size limit
                 if (totalSize > MAX_BATCH_SIZE) {
@@ -122,28 +182,275 @@ namespace CppMMO
                 }
             }
 
-            // Create single combined buffer
-            std::vector<std::byte> batchPacket;
-            batchPacket.reserve(totalSize);
-
-            // Combine all packets with their headers
-            for (const auto& packet : packets) {
-                uint32_t bodyLength = static_cast<uint32_t>(packet.size());
-                
-                // Add header (little endian)
-                batchPacket.insert(batchPacket.end(),
-                                   reinterpret_cast<const std::byte*>(&bodyLength),
-                                   reinterpret_cast<const std::byte*>(&bodyLength) + sizeof(uint32_t));
-                
-                // Add body
-                batchPacket.insert(batchPacket.end(), packet.begin(), packet.end());
+            size_t packetCount = framedPackets.size();
+            if (m_compressionEnabled.load(std::memory_order_relaxed) && totalSize >= m_config->compression_threshold_bytes)
+            {
+                // LZ4 needs contiguous input; frames are already size-prefixed, so this is a plain concatenation
+                std::vector<std::byte> batchPacket;
+                batchPacket.reserve(totalSize);
+                for (const auto& packet : framedPackets) {
+                    auto bytes = reinterpret_cast<const std::byte*>(packet.data());
+                    batchPacket.insert(batchPacket.end(), bytes, bytes + packet.size());
+                }
+                if (auto compressed = FrameCompression::Compress(batchPacket))
+                {
+                    Enqueue(OutboundPacket{std::move(*compressed), nullptr, true});
+                    LOG_DEBUG("Session {}: Compressed batch of {} packets ({} bytes total) added to write queue.",
+                             m_sessionId, packetCount, totalSize);
+                    return;
+                }
             }
 
-            m_writeQueue.enqueue(std::move(batchPacket));
-            m_timer.cancel_one();
+            // Uncompressed: the detached buffers go to the writer as they are and are gathered into the writev
+            Enqueue(OutboundPacket{{}, nullptr, true, {}, std::move(framedPackets)});
             
             LOG_DEBUG("Session {}: Batch of {} packets ({} bytes total) added to write queue.", 
-                     m_sessionId, packets.size(), totalSize);
+                     m_sessionId, packetCount, totalSize);
+        }
+
+        bool Session::EnableCompression()
+        {
+            if (!FrameCompression::IsAvailable() || m_config->compression_threshold_bytes == 0)
+            {
+                return false;
+            }
+            m_compressionEnabled.store(true, std::memory_order_relaxed);
+            LOG_DEBUG("Session {}: LZ4 batch compression enabled.", m_sessionId);
+            return true;
+        }
+
+        void Session::Enqueue(OutboundPacket packet)
+        {
+            size_t packetSize = packet.Size();
+
+            if (m_queuedBytes.load(std::memory_order_relaxed) + packetSize > m_config->send_budget_bytes)
+            {
+                if (m_config->slow_consumer_policy == SlowConsumerPolicy::DropSnapshots && packet.droppable)
+                {
+                    // Over budget: park the newest snapshot outside the queue, superseding any unsent one
+                    ReplacePendingSnapshot(std::move(packet));
+                    WakeWriter();
+                    return;
+                }
+                if (m_config->slow_consumer_policy == SlowConsumerPolicy::Disconnect)
+                {
+                    CheckSlowConsumerGrace();
+                }
+            }
+            else
+            {
+                m_overBudgetSinceMs.store(0, std::memory_order_relaxed);
+                if (packet.droppable && m_hasPendingSnapshot.load(std::memory_order_acquire))
+                {
+                    // The new snapshot goes through the queue, so the parked one is stale
+                    ReplacePendingSnapshot(std::nullopt);
+                }
+            }
+
+            size_t queuedBytes = m_queuedBytes.fetch_add(packetSize, std::memory_order_relaxed) + packetSize;
+            NetworkStats::Instance().RecordQueuedBytes(queuedBytes);
+            m_writeQueue.Push(std::make_unique<QueuedPacket>(std::move(packet)));
+            WakeWriter();
+        }
+
+        void Session::WakeWriter()
+        {
+            // Pairs with the fence in WriteLoop: either the writer sees our packet on its re-check,
+            // or we see that it has stopped. A busy writer costs only this load.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!m_writerActive.load(std::memory_order_relaxed) &&
+                !m_writerActive.exchange(true, std::memory_order_acq_rel))
+            {
+                if (m_handingOver.load(std::memory_order_seq_cst))
+                {
+                    // Detach has stopped the writer for good; this packet is not sent
+                    m_writerActive.store(false, std::memory_order_release);
+                    return;
+                }
+                // Idle sessions keep no writer coroutine frame around; start one for this burst
+                asio::co_spawn(m_socket.get_executor(), [self = shared_from_this()]() -> asio::awaitable<void>
+                {
+                    return self->WriteLoop();
+                }, asio::detached);
+            }
+        }
+
+        void Session::ReplacePendingSnapshot(std::optional<OutboundPacket> packet)
+        {
+            std::lock_guard<std::mutex> lock(m_pendingSnapshotMutex);
+            if (m_pendingSnapshot)
+            {
+                m_queuedBytes.fetch_sub(m_pendingSnapshot->Size(), std::memory_order_relaxed);
+                NetworkStats::Instance().RecordDroppedSnapshot();
+            }
+            if (packet)
+            {
+                m_queuedBytes.fetch_add(packet->Size(), std::memory_order_relaxed);
+            }
+            m_pendingSnapshot = std::move(packet);
+            m_hasPendingSnapshot.store(m_pendingSnapshot.has_value(), std::memory_order_release);
+        }
+
+        void Session::CheckSlowConsumerGrace()
+        {
+            int64_t nowMs = SteadyNowMs();
+            int64_t overBudgetSince = m_overBudgetSinceMs.load(std::memory_order_relaxed);
+            if (overBudgetSince == 0)
+            {
+                m_overBudgetSinceMs.compare_exchange_strong(overBudgetSince, nowMs, std::memory_order_relaxed);
+                return;
+            }
+
+            if (nowMs - overBudgetSince >= m_config->slow_consumer_grace.count() &&
+                !m_slowConsumerDisconnecting.exchange(true, std::memory_order_acq_rel))
+            {
+                LOG_WARN("Session {}: Slow consumer over send budget ({} queued bytes) for {}ms, disconnecting.",
+                        m_sessionId, m_queuedBytes.load(std::memory_order_relaxed), nowMs - overBudgetSince);
+                NetworkStats::Instance().RecordSlowConsumerDisconnect();
+                // Enqueue runs on producer threads; tear the socket down on its own executor
+                asio::post(m_socket.get_executor(), [self = shared_from_this()]()
+                {
+                    self->Disconnect();
+                });
+            }
+        }
+
+#ifdef BOOST_ASIO_HAS_IO_URING
+        void Session::UseRegisteredReceiveChunk(RegisteredReceiveChunk chunk)
+        {
+            m_receiveChunk = std::move(chunk);
+            m_receiveBuffer.AttachFixedStorage(m_receiveChunk ? m_receiveChunk.Bytes() : std::span<std::byte>());
+        }
+#endif
+
+        asio::awaitable<HandoverSession> Session::Detach(std::chrono::milliseconds drainTimeout)
+        {
+            HandoverSession handover;
+            asio::steady_timer timer(m_socket.get_executor());
+            auto deadline = std::chrono::steady_clock::now() + drainTimeout;
+            auto pause = [&timer]()
+            {
+                timer.expires_after(std::chrono::milliseconds(1));
+                return timer.async_wait(asio::as_tuple(asio::use_awaitable));
+            };
+
+            // Let what the last ticks queued reach the client so nothing reliable is lost
+            while (m_socket.is_open() && m_queuedBytes.load(std::memory_order_relaxed) > 0 && std::chrono::steady_clock::now() < deadline)
+            {
+                co_await pause();
+            }
+
+            // From here WakeWriter starts no writer; wait for the running one to finish its write
+            m_handingOver.store(true, std::memory_order_seq_cst);
+            while (m_writerActive.load(std::memory_order_seq_cst) && std::chrono::steady_clock::now() < deadline)
+            {
+                co_await pause();
+            }
+
+            // The reader may be between awaits on another thread (Shared mode), so cancel until it parks
+            while (!m_readerParked.load(std::memory_order_acquire) && m_socket.is_open() && std::chrono::steady_clock::now() < deadline)
+            {
+                boost::system::error_code ec;
+                m_socket.cancel(ec);
+                co_await pause();
+            }
+
+            if (!m_socket.is_open() || m_writerActive.load(std::memory_order_seq_cst) || !m_readerParked.load(std::memory_order_acquire))
+            {
+                LOG_WARN("Session {}: Could not be detached within {}ms, it will be closed.", m_sessionId, drainTimeout.count());
+                co_return handover;
+            }
+
+            // No loop touches the session any more. Completions for zero-copy sends still in flight
+            // arrive at the next process, which only needs the kernel's id counter to stay in step.
+            ReapZeroCopyCompletions();
+            handover.playerId = m_playerId;
+            handover.compression = m_compressionEnabled.load(std::memory_order_relaxed);
+            handover.zeroCopyNextId = m_zeroCopyNextId;
+            auto pending = m_receiveBuffer.Readable();
+            handover.pendingInput.assign(pending.begin(), pending.end());
+
+            boost::system::error_code ec;
+            handover.fd = m_socket.release(ec);
+            if (ec)
+            {
+                LOG_WARN("Session {}: Socket release failed: {}", m_sessionId, ec.message());
+                handover.fd = -1;
+            }
+            co_return handover;
+        }
+
+        void Session::Resume(const HandoverSession& handover)
+        {
+            m_playerId = handover.playerId;
+            if (handover.compression)
+            {
+                EnableCompression();
+            }
+            m_zeroCopyNextId = handover.zeroCopyNextId;
+            m_zeroCopyDoneCount.store(handover.zeroCopyNextId, std::memory_order_relaxed);
+            if (!handover.pendingInput.empty())
+            {
+                std::memcpy(m_receiveBuffer.PrepareWrite(handover.pendingInput.size()).data(),
+                            handover.pendingInput.data(), handover.pendingInput.size());
+                m_receiveBuffer.Commit(handover.pendingInput.size());
+            }
+            LOG_INFO("Session {}: Resumed from handover (player {}, {} buffered bytes).",
+                     m_sessionId, m_playerId, handover.pendingInput.size());
+        }
+
+        bool Session::MarkPacketDispatched(uint32_t sequence)
+        {
+            uint32_t dispatched = m_dispatchedSequence.load(std::memory_order_relaxed);
+            while (dispatched < sequence)
+            {
+                if (m_dispatchedSequence.compare_exchange_weak(dispatched, sequence, std::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        int64_t Session::GetDeadlineMs() const
+        {
+            int64_t deadline = std::numeric_limits<int64_t>::max();
+            if (m_config->read_idle_timeout.count() > 0)
+            {
+                deadline = m_lastReadMs.load(std::memory_order_relaxed) + m_config->read_idle_timeout.count();
+            }
+            int64_t writeStarted = m_writeStartedMs.load(std::memory_order_relaxed);
+            if (writeStarted != 0 && m_config->write_stall_timeout.count() > 0)
+            {
+                deadline = std::min(deadline, writeStarted + m_config->write_stall_timeout.count());
+            }
+            return deadline;
+        }
+
+        void Session::Expire()
+        {
+            if (m_expired.exchange(true, std::memory_order_acq_rel))
+            {
+                return;
+            }
+
+            int64_t idleMs = SteadyNowMs() - m_lastReadMs.load(std::memory_order_relaxed);
+            if (m_config->read_idle_timeout.count() > 0 && idleMs >= m_config->read_idle_timeout.count())
+            {
+                LOG_INFO("Session {}: Nothing received for {}ms, closing idle connection.", m_sessionId, idleMs);
+                NetworkStats::Instance().RecordReapedIdle();
+            }
+            else
+            {
+                LOG_WARN("Session {}: Write stalled for over {}ms ({} queued bytes), closing connection.",
+                        m_sessionId, m_config->write_stall_timeout.count(), m_queuedBytes.load(std::memory_order_relaxed));
+                NetworkStats::Instance().RecordReapedStalled();
+            }
+
+            asio::post(m_socket.get_executor(), [self = shared_from_this()]()
+            {
+                self->Disconnect();
+            });
         }
 
         uint64_t Session::GetPlayerId() const
@@ -163,65 +470,113 @@ namespace CppMMO
             {
                 while (true)
                 {
-                    auto [error, bytes_transferred] = co_await asio::async_read(m_socket, asio::buffer(m_readHeader), asio::as_tuple(asio::use_awaitable));
-                    if (error)
+                    if (m_handingOver.load(std::memory_order_acquire))
                     {
-                        HandleError(error, "ReadLoop header");
-                        Disconnect();
+                        m_readerParked.store(true, std::memory_order_release);
                         co_return;
                     }
 
-                    uint32_t bodyLength;
-                    std::memcpy(&bodyLength, m_readHeader.data(), sizeof(uint32_t));
-                    
-                    // Debug header value
-                    LOG_DEBUG("Session {}: Raw header bytes: {:02x} {:02x} {:02x} {:02x}", 
-                             m_sessionId, 
-                             static_cast<unsigned char>(m_readHeader[0]),
-                             static_cast<unsigned char>(m_readHeader[1]),
-                             static_cast<unsigned char>(m_readHeader[2]),
-                             static_cast<unsigned char>(m_readHeader[3]));
-                    
-                    // FlatBuffers SizedByteArray() is transmitted in little endian
-                    // Used as-is on server (host byte order = little endian)
-                    LOG_DEBUG("Session {}: Header body length (little endian): {}", m_sessionId, bodyLength);
-                    
-                    // Reasonable range check
-                    if (bodyLength == 0 || bodyLength > 100000)
-                    {
-                        LOG_ERROR("Session {}: Invalid header value: {}", m_sessionId, bodyLength);
-                        Disconnect();
-                        co_return;
-                    }
+                    boost::system::error_code error;
+                    size_t bytes_transferred = 0;
 
-                    m_readBody.resize(bodyLength);
-                    auto [body_error, body_bytes_transferred] = co_await asio::async_read(m_socket, asio::buffer(m_readBody), asio::as_tuple(asio::use_awaitable));
+                    bool readIntoScratch = m_receiveBuffer.Readable().empty();
+#ifdef BOOST_ASIO_HAS_IO_URING
+                    // Registered chunks come from a per-context arena, so those sessions keep reading into them
+                    readIntoScratch = readIntoScratch && !m_receiveChunk;
+#endif
+                    if (readIntoScratch)
+                    {
+                        // Nothing buffered: wait for readability without holding a buffer, then read into
+                        // this I/O thread's scratch space. Only a trailing partial frame is copied into
+                        // the session, so an idle session owns no receive storage at all.
+                        std::tie(error) = co_await m_socket.async_wait(ip::tcp::socket::wait_read, asio::as_tuple(asio::use_awaitable));
+                        if (!error)
+                        {
+                            static thread_local std::unique_ptr<std::byte[]> scratch = std::make_unique<std::byte[]>(READ_SCRATCH_SIZE);
+                            bytes_transferred = m_socket.read_some(asio::buffer(scratch.get(), READ_SCRATCH_SIZE), error);
+                            if (error == asio::error::would_block)
+                            {
+                                // Woken without data, e.g. by MSG_ZEROCOPY notifications: epoll reports the
+                                // error queue level-triggered, so empty it or the next wait returns at once.
+                                // The writer frees the matching buffers on its next run.
+                                DrainZeroCopyNotifications();
+                                continue;
+                            }
+                            if (!error)
+                            {
+                                m_lastReadMs.store(SteadyNowMs(), std::memory_order_relaxed);
 
-                    if (body_error)
+                                std::span<const std::byte> data(scratch.get(), bytes_transferred);
+                                size_t partialFrameSize = 0;
+                                auto consumed = DispatchFrames(data, partialFrameSize);
+                                if (!consumed)
+                                {
+                                    Disconnect();
+                                    co_return;
+                                }
+                                if (*consumed < data.size())
+                                {
+                                    auto rest = data.subspan(*consumed);
+                                    std::memcpy(m_receiveBuffer.PrepareWrite(rest.size()).data(), rest.data(), rest.size());
+                                    m_receiveBuffer.Commit(rest.size());
+                                    if (partialFrameSize > 0)
+                                    {
+                                        m_receiveBuffer.EnsureCapacity(partialFrameSize);
+                                    }
+                                }
+                                continue;
+                            }
+                        }
+                    }
+                    else
                     {
-                        HandleError(body_error, "ReadLoop body");
+                        // Read whatever is available, then parse every complete frame before suspending again
+                        auto writable = m_receiveBuffer.PrepareWrite(MIN_READ_SIZE);
+#ifdef BOOST_ASIO_HAS_IO_URING
+                        if (m_receiveChunk && m_receiveBuffer.UsingFixedStorage())
+                        {
+                            // Fixed-buffer read into this session's registered chunk
+                            auto registered = m_receiveChunk.Buffer() + static_cast<size_t>(writable.data() - m_receiveChunk.Bytes().data());
+                            std::tie(error, bytes_transferred) = co_await m_socket.async_read_some(
+                                asio::buffer(registered, writable.size()), asio::as_tuple(asio::use_awaitable));
+                        }
+                        else
+#endif
+                        {
+                            std::tie(error, bytes_transferred) = co_await m_socket.async_read_some(
+                                asio::buffer(writable.data(), writable.size()), asio::as_tuple(asio::use_awaitable));
+                        }
+                    }
+                    if (error)
+                    {
+                        if (error == asio::error::operation_aborted && m_handingOver.load(std::memory_order_acquire))
+                        {
+                            // Cancelled by Detach; the buffered bytes travel with the socket
+                            m_readerParked.store(true, std::memory_order_release);
+                            co_return;
+                        }
+                        HandleError(error, "ReadLoop");
                         Disconnect();
                         co_return;
                     }
+                    m_receiveBuffer.Commit(bytes_transferred);
+                    m_lastReadMs.store(SteadyNowMs(), std::memory_order_relaxed);
 
-                    if (m_packetManager)
+                    size_t partialFrameSize = 0;
+                    auto consumed = DispatchFrames(m_receiveBuffer.Readable(), partialFrameSize);
+                    if (!consumed)
                     {
-                        LOG_DEBUG("Session {}: Received packet - Header: {} bytes, Body: {} bytes", 
-                                 m_sessionId, m_readHeader.size(), m_readBody.size());
-                        
-                        // Debug hex dump (first 16 bytes)
-                        std::string hexDump;
-                        for(size_t i = 0; i < std::min(m_readBody.size(), size_t(16)); ++i) {
-                            hexDump += fmt::format("{:02x} ", static_cast<unsigned char>(m_readBody[i]));
-                        }
-                        LOG_DEBUG("Session {}: Body hex dump (first 16 bytes): {}", m_sessionId, hexDump);
-                        
-                        m_packetManager->HandlePacket(shared_from_this(), m_readBody);
+                        Disconnect();
+                        co_return;
                     }
-                    else
+                    m_receiveBuffer.Consume(*consumed);
+                    if (partialFrameSize > 0)
                     {
-                        LOG_ERROR("PacketManager is null in Session ReadLoop.");
+                        // Partial frame: make room for the rest of it and read more
+                        m_receiveBuffer.EnsureCapacity(partialFrameSize);
                     }
+                    // Once the partial frame has been dispatched the session goes back to owning nothing
+                    m_receiveBuffer.ReleaseIfDrained();
                 }
             }
             catch (const boost::system::system_error& e)
@@ -238,27 +593,135 @@ namespace CppMMO
             }
         }
 
+        std::optional<size_t> Session::DispatchFrames(std::span<const std::byte> data, size_t& partialFrameSize)
+        {
+            size_t consumed = 0;
+            while (data.size() - consumed >= sizeof(uint32_t))
+            {
+                // FlatBuffers SizedByteArray() is transmitted in little endian
+                // Used as-is on server (host byte order = little endian)
+                uint32_t bodyLength;
+                std::memcpy(&bodyLength, data.data() + consumed, sizeof(uint32_t));
+
+                // Reasonable range check
+                if (bodyLength == 0 || bodyLength > m_maxFrameBytes)
+                {
+                    LOG_ERROR("Session {}: Invalid header value: {} (max {})", m_sessionId, bodyLength, m_maxFrameBytes);
+                    return std::nullopt;
+                }
+
+                size_t frameSize = sizeof(uint32_t) + bodyLength;
+                if (data.size() - consumed < frameSize)
+                {
+                    partialFrameSize = frameSize;
+                    break;
+                }
+
+                auto body = data.subspan(consumed + sizeof(uint32_t), bodyLength);
+                consumed += frameSize;
+
+                // Over-budget frames are skipped here, before they are copied into a slab or queued
+                if (!m_ingressLimiter.Admit(body, SteadyNowMs()))
+                {
+                    uint64_t dropped = m_ingressLimiter.GetDroppedPackets();
+                    if (dropped == 1 || dropped % 1000 == 0)
+                    {
+                        LOG_WARN("Session {}: Ingress rate limit exceeded, {} packets dropped so far", m_sessionId, dropped);
+                    }
+                    continue;
+                }
+
+                if (m_packetManager)
+                {
+                    LOG_DEBUG("Session {}: Received packet - Body: {} bytes", m_sessionId, body.size());
+                    m_packetManager->HandlePacket(shared_from_this(), body);
+                }
+                else
+                {
+                    LOG_ERROR("PacketManager is null in Session ReadLoop.");
+                }
+            }
+            return consumed;
+        }
+
         asio::awaitable<void> Session::WriteLoop()
         {
             try
             {
                 while(m_socket.is_open())
                 {
-                    std::vector<std::byte> packetToSend;
-                    if(m_writeQueue.try_dequeue(packetToSend))
+                    if (!m_zeroCopyInFlight.empty())
                     {
-                        co_await asio::async_write(m_socket, asio::buffer(packetToSend), asio::use_awaitable);
-                        LOG_DEBUG("Session {}: Packet sent.", m_sessionId);
+                        ReapZeroCopyCompletions();
                     }
-                    else
+
+                    // Drain everything currently queued (up to the batch caps) into one gathered write
+                    size_t batchBytes = 0;
+                    m_writeBuffers.clear();
+                    while (m_writeBuffers.size() < MAX_WRITE_BATCH_BUFFERS && batchBytes < MAX_WRITE_BATCH_BYTES)
+                    {
+                        auto queued = m_writeQueue.Pop();
+                        if (!queued)
+                        {
+                            break;
+                        }
+                        batchBytes += queued->packet.Size();
+                        queued->packet.AppendBuffers(m_writeBuffers);
+                        m_writeBatch.push_back(std::move(queued->packet));
+                    }
+
+                    // Newest snapshot parked while over budget goes after the queued reliable packets
+                    if (m_hasPendingSnapshot.load(std::memory_order_acquire) && m_writeBuffers.size() < MAX_WRITE_BATCH_BUFFERS)
                     {
-                        boost::system::error_code ec;
-                        co_await m_timer.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+                        std::lock_guard<std::mutex> lock(m_pendingSnapshotMutex);
+                        if (m_pendingSnapshot)
+                        {
+                            batchBytes += m_pendingSnapshot->Size();
+                            m_pendingSnapshot->AppendBuffers(m_writeBuffers);
+                            m_writeBatch.push_back(std::move(*m_pendingSnapshot));
+                            m_pendingSnapshot.reset();
+                            m_hasPendingSnapshot.store(false, std::memory_order_release);
+                        }
+                    }
+
+                    if (!m_writeBatch.empty())
+                    {
+                        // The buffers point into the packets, which moving into m_writeBatch leaves in place
+                        m_writeStartedMs.store(SteadyNowMs(), std::memory_order_relaxed);
+                        if (m_zeroCopyEnabled && batchBytes >= m_config->zerocopy_threshold_bytes &&
+                            m_writeBuffers.size() <= MAX_WRITE_BATCH_BUFFERS)
+                        {
+                            co_await WriteZeroCopy(batchBytes);
+                        }
+                        else
+                        {
+                            co_await asio::async_write(m_socket, m_writeBuffers, asio::use_awaitable);
+                        }
+                        m_writeStartedMs.store(0, std::memory_order_relaxed);
+                        m_queuedBytes.fetch_sub(batchBytes, std::memory_order_relaxed);
 
-                        if (ec && ec != asio::error::operation_aborted)
+                        NetworkStats::Instance().RecordWrite(m_writeBuffers.size(), batchBytes);
+                        LOG_DEBUG("Session {}: {} packets ({} bytes) sent in one write.", m_sessionId, m_writeBatch.size(), batchBytes);
+                        m_writeBatch.clear();
+                    }
+                    else
+                    {
+                        // Announce we are stopping, then re-check so a packet enqueued meanwhile is not stranded
+                        m_writerActive.store(false, std::memory_order_relaxed);
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+                        if (m_writeQueue.Empty() && !m_hasPendingSnapshot.load(std::memory_order_relaxed))
                         {
-                            throw boost::system::system_error(ec, "WriteLoop timer wait failed");
+                            co_return;
                         }
+                        if (m_writerActive.exchange(true, std::memory_order_acq_rel))
+                        {
+                            // The producer has already started a new writer
+                            co_return;
+                        }
+                        // Either a packet landed after the last Pop, or a producer is between its head
+                        // exchange and linking the node (Pop sees nothing, Empty says otherwise).
+                        // Re-post instead of spinning so the I/O thread keeps serving other handlers.
+                        co_await asio::post(m_socket.get_executor(), asio::use_awaitable);
                     }
                 }
             }
@@ -276,6 +739,165 @@ namespace CppMMO
             }
         }
 
+        asio::awaitable<void> Session::WriteZeroCopy(size_t batchBytes)
+        {
+#ifdef CPPMMO_HAS_MSG_ZEROCOPY
+            ReapZeroCopyCompletions();
+            if (m_zeroCopyInFlight.size() >= MAX_ZEROCOPY_IN_FLIGHT)
+            {
+                // Too many batches pinned: poll for completions. Not a wait_error, because the reader
+                // may drain the error queue first and leave that wait with nothing to wake it.
+                asio::steady_timer timer(m_socket.get_executor());
+                while (m_zeroCopyInFlight.size() >= MAX_ZEROCOPY_IN_FLIGHT)
+                {
+                    timer.expires_after(std::chrono::microseconds(500));
+                    co_await timer.async_wait(asio::use_awaitable);
+                    ReapZeroCopyCompletions();
+                }
+            }
+
+            std::array<iovec, MAX_WRITE_BATCH_BUFFERS> iovecs;
+            size_t count = m_writeBuffers.size();
+            for (size_t i = 0; i < count; ++i)
+            {
+                iovecs[i].iov_base = const_cast<void*>(m_writeBuffers[i].data());
+                iovecs[i].iov_len = m_writeBuffers[i].size();
+            }
+
+            size_t first = 0;
+            bool queuedZeroCopy = false;
+            while (first < count)
+            {
+                msghdr message{};
+                message.msg_iov = iovecs.data() + first;
+                message.msg_iovlen = count - first;
+                ssize_t sent = ::sendmsg(m_socket.native_handle(), &message, MSG_ZEROCOPY | MSG_DONTWAIT | MSG_NOSIGNAL);
+                if (sent < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    {
+                        co_await m_socket.async_wait(ip::tcp::socket::wait_write, asio::use_awaitable);
+                        continue;
+                    }
+                    if (errno == ENOBUFS)
+                    {
+                        // Pinned-page allowance (optmem_max) used up: copy the rest the ordinary way
+                        std::vector<asio::const_buffer> rest;
+                        for (size_t i = first; i < count; ++i)
+                        {
+                            rest.emplace_back(iovecs[i].iov_base, iovecs[i].iov_len);
+                        }
+                        co_await asio::async_write(m_socket, rest, asio::use_awaitable);
+                        break;
+                    }
+                    throw boost::system::system_error(boost::system::error_code(errno, boost::system::system_category()), "sendmsg");
+                }
+
+                ++m_zeroCopyNextId;
+                queuedZeroCopy = true;
+                size_t remaining = static_cast<size_t>(sent);
+                while (remaining > 0)
+                {
+                    if (remaining >= iovecs[first].iov_len)
+                    {
+                        remaining -= iovecs[first].iov_len;
+                        ++first;
+                    }
+                    else
+                    {
+                        iovecs[first].iov_base = static_cast<char*>(iovecs[first].iov_base) + remaining;
+                        iovecs[first].iov_len -= remaining;
+                        remaining = 0;
+                    }
+                }
+            }
+
+            if (queuedZeroCopy)
+            {
+                // The kernel sends straight from these buffers, so they live until it says it is done
+                m_zeroCopyInFlight.push_back(ZeroCopyWrite{m_zeroCopyNextId - 1, std::move(m_writeBatch)});
+                m_writeBatch.clear();
+            }
+            NetworkStats::Instance().RecordZeroCopyWrite(batchBytes);
+#else
+            (void)batchBytes;
+            co_await asio::async_write(m_socket, m_writeBuffers, asio::use_awaitable);
+#endif
+        }
+
+        void Session::ReapZeroCopyCompletions()
+        {
+#ifdef CPPMMO_HAS_MSG_ZEROCOPY
+            DrainZeroCopyNotifications();
+
+            // TCP completes sends in order, so release the prefix the kernel is done with
+            uint32_t doneCount = m_zeroCopyDoneCount.load(std::memory_order_acquire);
+            auto pending = std::find_if(m_zeroCopyInFlight.begin(), m_zeroCopyInFlight.end(),
+                [doneCount](const ZeroCopyWrite& write) { return static_cast<int32_t>(write.lastId + 1 - doneCount) > 0; });
+            m_zeroCopyInFlight.erase(m_zeroCopyInFlight.begin(), pending);
+
+            if (m_zeroCopyEnabled && m_zeroCopyKernelCopied.load(std::memory_order_relaxed))
+            {
+                // The device could not send from user pages (e.g. loopback), so pinning is pure overhead
+                m_zeroCopyEnabled = false;
+                LOG_DEBUG("Session {}: Kernel copied a MSG_ZEROCOPY send, using regular writes.", m_sessionId);
+            }
+#endif
+        }
+
+        void Session::DrainZeroCopyNotifications()
+        {
+#ifdef CPPMMO_HAS_MSG_ZEROCOPY
+            alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))> control;
+            while (true)
+            {
+                msghdr message{};
+                message.msg_control = control.data();
+                message.msg_controllen = control.size();
+                if (::recvmsg(m_socket.native_handle(), &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+                {
+                    return;
+                }
+
+                for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header))
+                {
+                    bool isRecvErr = (header->cmsg_level == SOL_IP && header->cmsg_type == IP_RECVERR) ||
+                                     (header->cmsg_level == SOL_IPV6 && header->cmsg_type == IPV6_RECVERR);
+                    if (!isRecvErr)
+                    {
+                        continue;
+                    }
+
+                    sock_extended_err notification;
+                    std::memcpy(&notification, CMSG_DATA(header), sizeof(notification));
+                    if (notification.ee_origin != SO_EE_ORIGIN_ZEROCOPY || notification.ee_errno != 0)
+                    {
+                        continue;
+                    }
+
+                    // Ids [ee_info, ee_data] are done. Reader and writer may both drain, so only move forward.
+                    uint32_t doneCount = notification.ee_data + 1;
+                    uint32_t current = m_zeroCopyDoneCount.load(std::memory_order_relaxed);
+                    while (static_cast<int32_t>(doneCount - current) > 0 &&
+                           !m_zeroCopyDoneCount.compare_exchange_weak(current, doneCount, std::memory_order_release, std::memory_order_relaxed))
+                    {
+                    }
+
+                    bool copied = (notification.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0;
+                    NetworkStats::Instance().RecordZeroCopyCompletions(notification.ee_data - notification.ee_info + 1, copied);
+                    if (copied)
+                    {
+                        m_zeroCopyKernelCopied.store(true, std::memory_order_relaxed);
+                    }
+                }
+            }
+#endif
+        }
+
         void Session::HandleError(const boost::system::error_code& ec, std::string_view operation)
         {
             if (ec == asio::error::eof || ec == asio::error::operation_aborted)
@@ -2,6 +2,12 @@
 #include "pch.h"
 #include "ISession.h"
 #include "IPacketManager.h"
+#include "IService.h"
+#include "ReceiveBuffer.h"
+#include "IngressLimiter.h"
+#include "IntrusiveMpscQueue.h"
+#include "RegisteredReceivePool.h"
+#include "SocketHandover.h"
 #include <span>
 #include <cstddef>
 
@@ -15,41 +21,192 @@ namespace CppMMO
         class Session : public ISession, public std::enable_shared_from_this<Session>
         {
         public:
-            explicit Session(ip::tcp::socket socket, const std::shared_ptr<IPacketManager> packetManager);
+            // `config` is shared by every session of a server; nullptr uses the defaults
+            explicit Session(ip::tcp::socket socket, const std::shared_ptr<IPacketManager> packetManager,
+                             std::shared_ptr<const SessionConfig> config = nullptr);
             virtual ~Session() = default;
 
             virtual void Start() override;
             virtual void Disconnect() override;
             virtual ip::tcp::endpoint GetRemoteEndpoint() const override;
+            virtual asio::any_io_executor GetExecutor() override { return m_socket.get_executor(); }
             virtual bool IsConnected() const override;
             virtual void Send(std::span<const std::byte> data) override;
-            virtual void SendBatch(const std::vector<std::span<const std::byte>>& packets) override;
+            virtual void SendFramed(flatbuffers::DetachedBuffer packet) override;
+            virtual void SendBatch(std::vector<flatbuffers::DetachedBuffer> framedPackets) override;
+            virtual void SendShared(SharedPacket packet) override;
 
             virtual void SetOnDisconnectedCallback(const std::function<void(std::shared_ptr<ISession>)>& callback) override;
             virtual uint64_t GetSessionId() const override { return m_sessionId; }
             virtual uint64_t GetPlayerId() const override;
             virtual void SetPlayerId(uint64_t playerId) override;
+            virtual size_t GetQueuedBytes() const override { return m_queuedBytes.load(std::memory_order_relaxed); }
+            virtual uint32_t NextPacketSequence() override { return ++m_packetSequence; }
+            virtual bool MarkPacketDispatched(uint32_t sequence) override;
+            virtual bool EnableCompression() override;
+
+#ifdef BOOST_ASIO_HAS_IO_URING
+            // Reads go into `chunk` with io_uring fixed-buffer reads; call before Start()
+            void UseRegisteredReceiveChunk(RegisteredReceiveChunk chunk);
+#endif
+
+            // Handover to a replacement process: waits up to `drainTimeout` for queued output, stops
+            // the read and write loops and releases the socket without closing the connection. Runs
+            // on the session's executor; the returned fd is -1 if the session could not be detached.
+            asio::awaitable<HandoverSession> Detach(std::chrono::milliseconds drainTimeout);
+            // Restores what the previous process handed over with the socket; call before Start()
+            void Resume(const HandoverSession& handover);
+
+            // Earliest time (steady clock ms) at which the read-idle or write-stall deadline expires
+            int64_t GetDeadlineMs() const;
+            // Called by the reaper once the deadline has passed; disconnects on the socket's executor
+            void Expire();
+
+            static int64_t SteadyNowMs()
+            {
+                return std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+            }
         private:
             ip::tcp::socket m_socket;
+            ip::tcp::endpoint m_remoteEndpoint;    // Captured at construction; getpeername fails once the peer resets
             std::shared_ptr<IPacketManager> m_packetManager;
 
-            std::array<std::byte, 4> m_readHeader;
-            std::vector<std::byte> m_readBody;
+            static constexpr uint32_t MAX_PACKET_BODY_SIZE = 100000;
+            static constexpr size_t MIN_READ_SIZE = 2048;
+            static constexpr size_t READ_SCRATCH_SIZE = 64 * 1024;    // Per I/O thread, see ReadLoop
+            ReceiveBuffer m_receiveBuffer;
+#ifdef BOOST_ASIO_HAS_IO_URING
+            RegisteredReceiveChunk m_receiveChunk;
+#endif
+
+            // Write queue entry: a buffer owned by this session, a shared broadcast packet, a detached
+            // FlatBuffers buffer or an uncompressed snapshot batch kept as its separate frames
+            struct OutboundPacket
+            {
+                std::vector<std::byte> owned;
+                SharedPacket shared;
+                bool droppable = false;  // Snapshot batches may be superseded when over budget
+                flatbuffers::DetachedBuffer framed{};
+                std::vector<flatbuffers::DetachedBuffer> frames{};
+
+                size_t Size() const
+                {
+                    if (shared) return shared->Size();
+                    if (framed.size() > 0) return framed.size();
+                    if (!frames.empty())
+                    {
+                        size_t size = 0;
+                        for (const auto& frame : frames) size += frame.size();
+                        return size;
+                    }
+                    return owned.size();
+                }
+
+                // Adds one buffer per contiguous piece, in send order
+                void AppendBuffers(std::vector<asio::const_buffer>& buffers) const
+                {
+                    if (shared)
+                    {
+                        auto bytes = shared->Bytes();
+                        buffers.emplace_back(bytes.data(), bytes.size());
+                    }
+                    else if (framed.size() > 0)
+                    {
+                        buffers.emplace_back(framed.data(), framed.size());
+                    }
+                    else if (!frames.empty())
+                    {
+                        for (const auto& frame : frames) buffers.emplace_back(frame.data(), frame.size());
+                    }
+                    else
+                    {
+                        buffers.emplace_back(owned.data(), owned.size());
+                    }
+                }
+            };
+
+            struct QueuedPacket : MpscNode
+            {
+                explicit QueuedPacket(OutboundPacket p) : packet(std::move(p)) {}
+                OutboundPacket packet;
+            };
 
-            moodycamel::ConcurrentQueue<std::vector<std::byte>> m_writeQueue;
+            // Producers are the game, logic and I/O threads; WriteLoop is the only consumer
+            IntrusiveMpscQueue<QueuedPacket> m_writeQueue;
 
-            asio::steady_timer m_timer;
+            // Gathered write state, only touched by WriteLoop
+            // asio passes at most 64 iovecs per writev. Soft cap: a snapshot batch's frames may overshoot
+            // it, in which case asio splits the write and the zero-copy path (one iovec array) is skipped.
+            static constexpr size_t MAX_WRITE_BATCH_BUFFERS = 64;
+            static constexpr size_t MAX_WRITE_BATCH_BYTES = 256 * 1024;
+            std::vector<OutboundPacket> m_writeBatch;
+            std::vector<asio::const_buffer> m_writeBuffers;
+
+            // MSG_ZEROCOPY writes whose pages the kernel may still reference, oldest first; WriteLoop only
+            struct ZeroCopyWrite
+            {
+                uint32_t lastId;                        // Notification id of the write's final sendmsg
+                std::vector<OutboundPacket> packets;    // Released once the kernel reports lastId complete
+            };
+            static constexpr size_t MAX_ZEROCOPY_IN_FLIGHT = 32;
+            std::vector<ZeroCopyWrite> m_zeroCopyInFlight;
+            uint32_t m_zeroCopyNextId = 0;   // The kernel numbers successful MSG_ZEROCOPY sendmsg calls from 0
+            bool m_zeroCopyEnabled = false;
+            // Written by whichever loop drains the error queue (see DrainZeroCopyNotifications)
+            std::atomic<uint32_t> m_zeroCopyDoneCount{0};       // Last completed id + 1, modulo 2^32
+            std::atomic<bool> m_zeroCopyKernelCopied{false};
+
+            // Outbound byte budget and slow-consumer handling
+            std::shared_ptr<const SessionConfig> m_config;
+            std::atomic<size_t> m_queuedBytes{0};
+            std::mutex m_pendingSnapshotMutex;
+            std::optional<OutboundPacket> m_pendingSnapshot;   // Newest snapshot batch while over budget
+            std::atomic<bool> m_hasPendingSnapshot{false};
+            std::atomic<int64_t> m_overBudgetSinceMs{0};
+            std::atomic<bool> m_slowConsumerDisconnecting{false};
+            std::atomic<bool> m_compressionEnabled{false};  // Set at login, read by the game thread in SendBatch
+
+            // True while a WriteLoop coroutine exists. Idle sessions have none; the producer that
+            // flips this from false starts one.
+            std::atomic<bool> m_writerActive{false};
             uint64_t m_sessionId;
             uint64_t m_playerId = 0;
 
-            // TODO : Set Timeout For Read & Write
-            // std::chrono::steady_clock::time_point m_readDeadline;
-            // std::chrono::steady_clock::time_point m_writeDeadline;
+            // Activity timestamps for the reaper (steady clock ms); m_writeStartedMs is 0 while no write is in flight
+            std::atomic<int64_t> m_lastReadMs;
+            std::atomic<int64_t> m_writeStartedMs{0};
+            std::atomic<bool> m_expired{false};
+
+            // Ingress validation and rate limiting, only touched by ReadLoop
+            IngressLimiter m_ingressLimiter;
+            uint32_t m_maxFrameBytes;
+            uint32_t m_packetSequence = 0;                  // ReadLoop only
+            std::atomic<uint32_t> m_dispatchedSequence{0};  // Highest sequence a packet worker has dispatched
             
             std::function<void(std::shared_ptr<ISession>)> m_onDisconnectedCallback{};
+            std::atomic<bool> m_disconnectNotified{false};   // Read and write loops may both call Disconnect
+
+            // Set by Detach: no new writer is started and ReadLoop parks instead of disconnecting
+            std::atomic<bool> m_handingOver{false};
+            std::atomic<bool> m_readerParked{false};
             
             asio::awaitable<void> ReadLoop();
             asio::awaitable<void> WriteLoop();
+            // Sends m_writeBuffers with MSG_ZEROCOPY and parks m_writeBatch until completion
+            asio::awaitable<void> WriteZeroCopy(size_t batchBytes);
+            void ReapZeroCopyCompletions();
+            void DrainZeroCopyNotifications();
+
+            // Hands every complete frame in `data` to the packet manager. Returns the bytes consumed,
+            // or nullopt on a protocol violation. `partialFrameSize` is set when a trailing frame's
+            // header has arrived but its body has not.
+            std::optional<size_t> DispatchFrames(std::span<const std::byte> data, size_t& partialFrameSize);
+
+            void Enqueue(OutboundPacket packet);
+            void ReplacePendingSnapshot(std::optional<OutboundPacket> packet);
+            void CheckSlowConsumerGrace();
+            void WakeWriter();
 
             void HandleError(const boost::system::error_code& ec, std::string_view operation);
 
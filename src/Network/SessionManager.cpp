@@ -84,16 +84,12 @@ namespace CppMMO
 
             if(playerId != 0 && m_gameLogicQueue)
             {
-                Game::PlayerDisconnectCommandData disconnectData;
-                disconnectData.playerId = playerId;
+                Game::CompactGameCommand command;
+                command.type = Game::CompactCommandType::PlayerDisconnect;
+                command.playerId = playerId;
+                command.sessionId = session->GetSessionId();
 
-                Game::GameCommand command;
-                command.commandId = 0;
-                command.payload = Game::GameCommandPayload{disconnectData};
-                command.senderSessionId = session->GetSessionId();
-                command.timestamp = Game::GetCurrentTimestamp();
-
-                m_gameLogicQueue->PushGameCommand(command);
+                m_gameLogicQueue->PushCompactCommand(command);
 
                 LOG_INFO("SessionManager: Queued disconnect command for player {}", playerId);
             }
@@ -0,0 +1,123 @@
+#include "pch.h"
+#include "SessionReaper.h"
+#include "Session.h"
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        SessionReaper::SessionReaper(asio::io_context& io_context, std::chrono::milliseconds tickInterval,
+                                     std::chrono::milliseconds recheckHorizon, size_t wheelSize)
+            : m_timer(io_context),
+              m_tickInterval(tickInterval.count() > 0 ? tickInterval : std::chrono::milliseconds(1000)),
+              m_recheckHorizon(recheckHorizon),
+              m_wheel(wheelSize > 1 ? wheelSize : 2)
+        {
+        }
+
+        void SessionReaper::Start()
+        {
+            m_running.store(true, std::memory_order_release);
+            m_currentTickMs = Session::SteadyNowMs();
+            ScheduleTick();
+            LOG_INFO("SessionReaper started: {} slots, {}ms per tick.", m_wheel.size(), m_tickInterval.count());
+        }
+
+        void SessionReaper::Stop()
+        {
+            m_running.store(false, std::memory_order_release);
+            asio::post(m_timer.get_executor(), [self = shared_from_this()]()
+            {
+                self->m_timer.cancel();
+            });
+        }
+
+        void SessionReaper::Add(const std::shared_ptr<Session>& session)
+        {
+            std::lock_guard<std::mutex> lock(m_pendingMutex);
+            m_pending.emplace_back(session);
+        }
+
+        void SessionReaper::ScheduleTick()
+        {
+            m_timer.expires_after(m_tickInterval);
+            m_timer.async_wait([self = shared_from_this()](const boost::system::error_code& ec)
+            {
+                if (!ec && self->m_running.load(std::memory_order_acquire))
+                {
+                    self->OnTick();
+                }
+            });
+        }
+
+        void SessionReaper::OnTick()
+        {
+            m_currentSlot = (m_currentSlot + 1) % m_wheel.size();
+            m_currentTickMs = Session::SteadyNowMs();
+
+            {
+                std::lock_guard<std::mutex> lock(m_pendingMutex);
+                m_dueScratch.swap(m_pending);
+            }
+            for (auto& weakSession : m_dueScratch)
+            {
+                if (auto session = weakSession.lock())
+                {
+                    Schedule(std::move(weakSession), session->GetDeadlineMs());
+                }
+            }
+            m_dueScratch.clear();
+
+            // Entries in the due slot are only candidates; sessions that saw activity are re-slotted
+            m_dueScratch.swap(m_wheel[m_currentSlot]);
+            for (auto& weakSession : m_dueScratch)
+            {
+                auto session = weakSession.lock();
+                if (!session || !session->IsConnected())
+                {
+                    continue;
+                }
+
+                int64_t deadlineMs = session->GetDeadlineMs();
+                if (deadlineMs <= m_currentTickMs)
+                {
+                    m_expiredScratch.push_back(std::move(session));
+                }
+                else
+                {
+                    Schedule(std::move(weakSession), deadlineMs);
+                }
+            }
+            m_dueScratch.clear();
+
+            if (!m_expiredScratch.empty())
+            {
+                LOG_INFO("SessionReaper: Expiring {} dead sessions.", m_expiredScratch.size());
+                for (auto& session : m_expiredScratch)
+                {
+                    session->Expire();
+                }
+                m_expiredScratch.clear();
+            }
+
+            ScheduleTick();
+        }
+
+        void SessionReaper::Schedule(std::weak_ptr<Session> session, int64_t deadlineMs)
+        {
+            // A write that starts after this check is only seen at the next one, so never park beyond the horizon
+            if (m_recheckHorizon.count() > 0)
+            {
+                deadlineMs = std::min(deadlineMs, m_currentTickMs + m_recheckHorizon.count());
+            }
+            // Deadlines past one revolution land in the furthest slot and are re-checked from there
+            int64_t tickMs = m_tickInterval.count();
+            int64_t remainingMs = deadlineMs - m_currentTickMs;
+            int64_t ticksAhead = remainingMs / tickMs + (remainingMs % tickMs != 0 ? 1 : 0);
+            ticksAhead = std::clamp<int64_t>(ticksAhead, 1, static_cast<int64_t>(m_wheel.size()) - 1);
+
+            size_t slot = (m_currentSlot + static_cast<size_t>(ticksAhead)) % m_wheel.size();
+            m_wheel[slot].push_back(std::move(session));
+        }
+    }
+}
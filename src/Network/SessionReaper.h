@@ -0,0 +1,60 @@
+#pragma once
+#include "pch.h"
+
+namespace asio = boost::asio;
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        class Session;
+
+        /**
+         * @brief Hashed timer wheel that closes sessions whose read-idle or write-stall deadline passed.
+         *
+         * Sessions only bump atomic activity timestamps on the hot path. The wheel keeps one weak
+         * reference per session in the slot of its last known deadline; when the slot comes due the
+         * deadline is re-read, and the session is either re-slotted (it was active meanwhile) or
+         * collected into this tick's batch and expired. Each tick touches only the sessions in one
+         * slot, so the cost does not grow with idle connections that are still healthy.
+         * A session is never parked further out than `recheckHorizon`. A session with no deadline
+         * (read-idle off, no write in flight) can start a write that stalls at any moment, so it
+         * must be looked at again within one write-stall timeout.
+         * Create with std::make_shared; pending timer handlers keep the reaper alive.
+         */
+        class SessionReaper : public std::enable_shared_from_this<SessionReaper>
+        {
+        public:
+            // `recheckHorizon` caps how far ahead a session is parked; 0 leaves it at one wheel revolution
+            SessionReaper(asio::io_context& io_context, std::chrono::milliseconds tickInterval,
+                          std::chrono::milliseconds recheckHorizon = std::chrono::milliseconds(0), size_t wheelSize = 64);
+
+            void Start();
+            // Safe from any thread; the timer itself is only touched on its executor
+            void Stop();
+
+            // Registers a new session; safe to call from any I/O thread.
+            void Add(const std::shared_ptr<Session>& session);
+
+        private:
+            void ScheduleTick();
+            void OnTick();
+            void Schedule(std::weak_ptr<Session> session, int64_t deadlineMs);
+
+            asio::steady_timer m_timer;
+            std::chrono::milliseconds m_tickInterval;
+            std::chrono::milliseconds m_recheckHorizon;
+            std::atomic<bool> m_running{false};
+
+            // Touched only from the timer handler
+            std::vector<std::vector<std::weak_ptr<Session>>> m_wheel;
+            size_t m_currentSlot = 0;
+            int64_t m_currentTickMs = 0;
+            std::vector<std::weak_ptr<Session>> m_dueScratch;
+            std::vector<std::shared_ptr<Session>> m_expiredScratch;
+
+            std::mutex m_pendingMutex;
+            std::vector<std::weak_ptr<Session>> m_pending;
+        };
+    }
+}
@@ -0,0 +1,429 @@
+#include "pch.h"
+#include "SocketHandover.h"
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        namespace
+        {
+            constexpr uint32_t HANDOVER_MAGIC = 0x484F4D43;     // "CMOH"
+            constexpr uint32_t HANDOVER_VERSION = 1;
+            constexpr size_t MAX_FDS_PER_MESSAGE = 250;          // Kernel limit is SCM_MAX_FD (253)
+            constexpr size_t METADATA_CHUNK_BYTES = 32 * 1024;   // Well under the default socket buffer
+
+            struct HandoverHeader
+            {
+                uint32_t magic = HANDOVER_MAGIC;
+                uint32_t version = HANDOVER_VERSION;
+                uint32_t listenerCount = 0;
+                uint32_t sessionCount = 0;
+                uint64_t metadataBytes = 0;
+            };
+
+#ifdef __linux__
+            void CloseFd(int fd)
+            {
+                if (fd >= 0)
+                {
+                    ::close(fd);
+                }
+            }
+
+            bool SendMessage(int channel, const void* data, size_t size, std::span<const int> fds = {})
+            {
+                iovec iov{const_cast<void*>(data), size};
+                msghdr message{};
+                message.msg_iov = &iov;
+                message.msg_iovlen = 1;
+
+                alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int) * MAX_FDS_PER_MESSAGE)> control{};
+                if (!fds.empty())
+                {
+                    message.msg_control = control.data();
+                    message.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+                    cmsghdr* header = CMSG_FIRSTHDR(&message);
+                    header->cmsg_level = SOL_SOCKET;
+                    header->cmsg_type = SCM_RIGHTS;
+                    header->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+                    std::memcpy(CMSG_DATA(header), fds.data(), sizeof(int) * fds.size());
+                }
+
+                while (true)
+                {
+                    ssize_t sent = ::sendmsg(channel, &message, MSG_NOSIGNAL);
+                    if (sent >= 0)
+                    {
+                        return static_cast<size_t>(sent) == size;
+                    }
+                    if (errno != EINTR)
+                    {
+                        LOG_ERROR("Handover: sendmsg failed: {}", std::strerror(errno));
+                        return false;
+                    }
+                }
+            }
+
+            // Receives one message of at most `size` bytes; descriptors attached to it are appended to `fds`
+            std::optional<size_t> ReceiveMessage(int channel, void* data, size_t size, std::vector<int>* fds = nullptr)
+            {
+                iovec iov{data, size};
+                msghdr message{};
+                message.msg_iov = &iov;
+                message.msg_iovlen = 1;
+                alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int) * MAX_FDS_PER_MESSAGE)> control{};
+                message.msg_control = control.data();
+                message.msg_controllen = control.size();
+
+                ssize_t received = 0;
+                do
+                {
+                    received = ::recvmsg(channel, &message, MSG_CMSG_CLOEXEC);
+                } while (received < 0 && errno == EINTR);
+
+                for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header))
+                {
+                    if (header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS)
+                    {
+                        continue;
+                    }
+                    size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+                    const auto* incoming = reinterpret_cast<const int*>(CMSG_DATA(header));
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        int fd = -1;
+                        std::memcpy(&fd, incoming + i, sizeof(int));
+                        if (fds)
+                        {
+                            fds->push_back(fd);
+                        }
+                        else
+                        {
+                            CloseFd(fd);
+                        }
+                    }
+                }
+
+                if (received <= 0 || (message.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) != 0)
+                {
+                    LOG_ERROR("Handover: recvmsg failed: {}", received < 0 ? std::strerror(errno) : "truncated or closed");
+                    return std::nullopt;
+                }
+                return static_cast<size_t>(received);
+            }
+
+            std::optional<sockaddr_un> MakeAddress(const std::string& path)
+            {
+                sockaddr_un address{};
+                address.sun_family = AF_UNIX;
+                if (path.empty() || path.size() >= sizeof(address.sun_path))
+                {
+                    LOG_ERROR("Handover: socket path '{}' is empty or too long.", path);
+                    return std::nullopt;
+                }
+                std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+                return address;
+            }
+#endif
+        }
+
+        void HandoverPackage::CloseAll()
+        {
+#ifdef __linux__
+            for (int fd : listenerFds)
+            {
+                CloseFd(fd);
+            }
+            for (auto& session : sessions)
+            {
+                CloseFd(session.fd);
+                session.fd = -1;
+            }
+#endif
+            listenerFds.clear();
+        }
+
+        HandoverChannel::~HandoverChannel()
+        {
+#ifdef __linux__
+            CloseFd(m_fd);
+#endif
+        }
+
+        HandoverChannel& HandoverChannel::operator=(HandoverChannel&& other) noexcept
+        {
+            if (this != &other)
+            {
+#ifdef __linux__
+                CloseFd(m_fd);
+#endif
+                m_fd = std::exchange(other.m_fd, -1);
+            }
+            return *this;
+        }
+
+        std::optional<HandoverChannel> HandoverChannel::Listen(const std::string& path)
+        {
+#ifdef __linux__
+            auto address = MakeAddress(path);
+            if (!address)
+            {
+                return std::nullopt;
+            }
+
+            HandoverChannel channel(::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0));
+            if (!channel.IsOpen())
+            {
+                LOG_ERROR("Handover: socket() failed: {}", std::strerror(errno));
+                return std::nullopt;
+            }
+            // A file left behind by a crashed process would make bind fail
+            ::unlink(path.c_str());
+            if (::bind(channel.m_fd, reinterpret_cast<const sockaddr*>(&*address), sizeof(sockaddr_un)) != 0 ||
+                ::listen(channel.m_fd, 1) != 0)
+            {
+                LOG_ERROR("Handover: cannot listen on '{}': {}", path, std::strerror(errno));
+                return std::nullopt;
+            }
+            return channel;
+#else
+            LOG_WARN("Handover: not supported on this platform (path '{}').", path);
+            return std::nullopt;
+#endif
+        }
+
+        std::optional<HandoverChannel> HandoverChannel::Connect(const std::string& path)
+        {
+#ifdef __linux__
+            auto address = MakeAddress(path);
+            if (!address)
+            {
+                return std::nullopt;
+            }
+
+            HandoverChannel channel(::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0));
+            if (!channel.IsOpen() ||
+                ::connect(channel.m_fd, reinterpret_cast<const sockaddr*>(&*address), sizeof(sockaddr_un)) != 0)
+            {
+                LOG_ERROR("Handover: cannot connect to '{}': {}", path, std::strerror(errno));
+                return std::nullopt;
+            }
+            return channel;
+#else
+            LOG_WARN("Handover: not supported on this platform (path '{}').", path);
+            return std::nullopt;
+#endif
+        }
+
+        std::optional<HandoverChannel> HandoverChannel::Accept()
+        {
+#ifdef __linux__
+            while (m_fd >= 0)
+            {
+                int fd = ::accept4(m_fd, nullptr, nullptr, SOCK_CLOEXEC);
+                if (fd >= 0)
+                {
+                    return HandoverChannel(fd);
+                }
+                if (errno != EINTR && errno != ECONNABORTED)
+                {
+                    // EINVAL after Shutdown()
+                    return std::nullopt;
+                }
+            }
+#endif
+            return std::nullopt;
+        }
+
+        void HandoverChannel::Shutdown()
+        {
+#ifdef __linux__
+            if (m_fd >= 0)
+            {
+                ::shutdown(m_fd, SHUT_RDWR);
+            }
+#endif
+        }
+
+        bool HandoverChannel::SendPackage(const HandoverPackage& package)
+        {
+#ifdef __linux__
+            nlohmann::json sessions = nlohmann::json::array();
+            std::vector<int> fds = package.listenerFds;
+            for (const auto& session : package.sessions)
+            {
+                const auto* pending = reinterpret_cast<const uint8_t*>(session.pendingInput.data());
+                sessions.push_back({
+                    {"player_id", session.playerId},
+                    {"compression", session.compression},
+                    {"zerocopy_next_id", session.zeroCopyNextId},
+                    {"pending_input", nlohmann::json::binary(std::vector<uint8_t>(pending, pending + session.pendingInput.size()))},
+                });
+                fds.push_back(session.fd);
+            }
+            std::vector<uint8_t> metadata = nlohmann::json::to_cbor(nlohmann::json{
+                {"sessions", std::move(sessions)},
+                {"game", package.gameState},
+            });
+
+            HandoverHeader header;
+            header.listenerCount = static_cast<uint32_t>(package.listenerFds.size());
+            header.sessionCount = static_cast<uint32_t>(package.sessions.size());
+            header.metadataBytes = metadata.size();
+            if (!SendMessage(m_fd, &header, sizeof(header)))
+            {
+                return false;
+            }
+
+            for (size_t first = 0; first < fds.size(); first += MAX_FDS_PER_MESSAGE)
+            {
+                size_t count = std::min(MAX_FDS_PER_MESSAGE, fds.size() - first);
+                char marker = 'F';
+                if (!SendMessage(m_fd, &marker, sizeof(marker), std::span<const int>(fds).subspan(first, count)))
+                {
+                    return false;
+                }
+            }
+
+            for (size_t offset = 0; offset < metadata.size(); offset += METADATA_CHUNK_BYTES)
+            {
+                if (!SendMessage(m_fd, metadata.data() + offset, std::min(METADATA_CHUNK_BYTES, metadata.size() - offset)))
+                {
+                    return false;
+                }
+            }
+            return true;
+#else
+            (void)package;
+            return false;
+#endif
+        }
+
+        std::optional<HandoverPackage> HandoverChannel::ReceivePackage()
+        {
+#ifdef __linux__
+            HandoverHeader header;
+            auto headerBytes = ReceiveMessage(m_fd, &header, sizeof(header));
+            if (!headerBytes || *headerBytes != sizeof(header) || header.magic != HANDOVER_MAGIC || header.version != HANDOVER_VERSION)
+            {
+                LOG_ERROR("Handover: unexpected header from the previous process.");
+                return std::nullopt;
+            }
+
+            size_t expectedFds = static_cast<size_t>(header.listenerCount) + header.sessionCount;
+            std::vector<int> fds;
+            fds.reserve(expectedFds);
+            auto closeReceived = [&fds]()
+            {
+                for (int fd : fds)
+                {
+                    CloseFd(fd);
+                }
+            };
+            while (fds.size() < expectedFds)
+            {
+                char marker = 0;
+                if (!ReceiveMessage(m_fd, &marker, sizeof(marker), &fds))
+                {
+                    closeReceived();
+                    return std::nullopt;
+                }
+            }
+            if (fds.size() != expectedFds)
+            {
+                LOG_ERROR("Handover: expected {} descriptors, received {}.", expectedFds, fds.size());
+                closeReceived();
+                return std::nullopt;
+            }
+
+            std::vector<uint8_t> metadata(header.metadataBytes);
+            for (size_t offset = 0; offset < metadata.size();)
+            {
+                auto chunk = ReceiveMessage(m_fd, metadata.data() + offset, std::min(METADATA_CHUNK_BYTES, metadata.size() - offset));
+                if (!chunk)
+                {
+                    closeReceived();
+                    return std::nullopt;
+                }
+                offset += *chunk;
+            }
+
+            HandoverPackage package;
+            try
+            {
+                nlohmann::json document = nlohmann::json::from_cbor(metadata);
+                const auto& sessions = document.at("sessions");
+                if (sessions.size() != header.sessionCount)
+                {
+                    throw std::runtime_error("session count does not match the header");
+                }
+
+                package.listenerFds.assign(fds.begin(), fds.begin() + header.listenerCount);
+                for (size_t i = 0; i < sessions.size(); ++i)
+                {
+                    const auto& entry = sessions[i];
+                    HandoverSession& session = package.sessions.emplace_back();
+                    session.fd = fds[header.listenerCount + i];
+                    session.playerId = entry.at("player_id").get<uint64_t>();
+                    session.compression = entry.at("compression").get<bool>();
+                    session.zeroCopyNextId = entry.at("zerocopy_next_id").get<uint32_t>();
+                    const auto& pending = entry.at("pending_input").get_binary();
+                    const auto* bytes = reinterpret_cast<const std::byte*>(pending.data());
+                    session.pendingInput.assign(bytes, bytes + pending.size());
+                }
+                package.gameState = std::move(document.at("game"));
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("Handover: malformed metadata: {}", e.what());
+                closeReceived();
+                return std::nullopt;
+            }
+            return package;
+#else
+            return std::nullopt;
+#endif
+        }
+
+        bool HandoverChannel::SendAck()
+        {
+#ifdef __linux__
+            char ack = 'A';
+            return SendMessage(m_fd, &ack, sizeof(ack));
+#else
+            return false;
+#endif
+        }
+
+        bool HandoverChannel::WaitAck(std::chrono::milliseconds timeout)
+        {
+#ifdef __linux__
+            pollfd waiter{m_fd, POLLIN, 0};
+            int ready = 0;
+            do
+            {
+                ready = ::poll(&waiter, 1, static_cast<int>(timeout.count()));
+            } while (ready < 0 && errno == EINTR);
+            if (ready <= 0)
+            {
+                LOG_ERROR("Handover: no acknowledgement from the next process within {}ms.", timeout.count());
+                return false;
+            }
+            char ack = 0;
+            auto received = ReceiveMessage(m_fd, &ack, sizeof(ack));
+            return received && ack == 'A';
+#else
+            (void)timeout;
+            return false;
+#endif
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "pch.h"
+#include <nlohmann/json.hpp>
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        // One client connection passed to the next process, with the session state it needs to resume
+        struct HandoverSession
+        {
+            int fd = -1;
+            uint64_t playerId = 0;
+            bool compression = false;
+            uint32_t zeroCopyNextId = 0;            // Kernel MSG_ZEROCOPY numbering continues on the socket
+            std::vector<std::byte> pendingInput;    // Received bytes of a frame that was not complete yet
+        };
+
+        struct HandoverPackage
+        {
+            std::vector<int> listenerFds;
+            std::vector<HandoverSession> sessions;
+            nlohmann::json gameState;               // Opaque to the network layer, see TcpServer::SetHandoverHandlers
+
+            // Closes every descriptor still owned by the package
+            void CloseAll();
+        };
+
+        /**
+         * @brief Unix-domain channel that moves a running server's sockets to its replacement.
+         *
+         * The old process listens on a filesystem path; the new one connects and receives one
+         * HandoverPackage. Descriptors travel as SCM_RIGHTS ancillary data over SOCK_SEQPACKET, the
+         * metadata as a CBOR document, and the receiver acknowledges once it owns everything so the
+         * sender knows it may exit. Linux only; elsewhere every call fails.
+         */
+        class HandoverChannel
+        {
+        public:
+            HandoverChannel() = default;
+            ~HandoverChannel();
+
+            HandoverChannel(HandoverChannel&& other) noexcept : m_fd(std::exchange(other.m_fd, -1)) {}
+            HandoverChannel& operator=(HandoverChannel&& other) noexcept;
+            HandoverChannel(const HandoverChannel&) = delete;
+            HandoverChannel& operator=(const HandoverChannel&) = delete;
+
+            // Binds `path` (replacing a stale socket file) and listens for the next process
+            static std::optional<HandoverChannel> Listen(const std::string& path);
+            static std::optional<HandoverChannel> Connect(const std::string& path);
+
+            // Listening channel: blocks for the next process. Fails once Shutdown() has been called.
+            std::optional<HandoverChannel> Accept();
+            // Wakes a thread blocked in Accept(); safe to call from any thread
+            void Shutdown();
+
+            bool IsOpen() const { return m_fd >= 0; }
+
+            bool SendPackage(const HandoverPackage& package);
+            std::optional<HandoverPackage> ReceivePackage();
+
+            bool SendAck();
+            bool WaitAck(std::chrono::milliseconds timeout);
+
+        private:
+            explicit HandoverChannel(int fd) : m_fd(fd) {}
+
+            int m_fd = -1;
+        };
+    }
+}
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "TcpServer.h"
+#include "NetworkStats.h"
 
 namespace asio = boost::asio;
 namespace ip = boost::asio::ip;
@@ -13,26 +14,18 @@ namespace CppMMO
                             std::shared_ptr<IPacketManager> packetManager,
                             std::shared_ptr<ISessionManager> sessionManager)
                             : m_ioContext(io_context),
-                            m_acceptor(io_context, ip::tcp::endpoint(ip::tcp::v4(), port)),
+                            m_port(port),
+                            m_acceptor(asio::make_strand(io_context)),
                             m_packetManager(packetManager),
                             m_sessionManager(sessionManager),
                             m_signals(io_context, SIGINT, SIGTERM)
         {
-            // Enable address reuse to prevent "Address already in use" errors
-            m_acceptor.set_option(ip::tcp::acceptor::reuse_address(true));
-            
-            // Disable linger to prevent TIME_WAIT issues
-            boost::asio::socket_base::linger linger_option(false, 0);
-            m_acceptor.set_option(linger_option);
-            
-            LOG_INFO("TcpServer Created. Listening on port {} with SO_REUSEADDR and SO_LINGER disabled", port);
-
             m_signals.async_wait([this](const boost::system::error_code& ec, int signal_number)
             {
                 if (!ec) 
                 {
                     LOG_INFO("Received signal {}. Stopping server...", signal_number);
-                    m_ioContext.stop();
+                    StopContexts();
                 }
             });
         }
@@ -53,18 +46,120 @@ namespace CppMMO
                     return false;
                 }
 
-                m_acceptor.listen(128);
-                LOG_INFO("TcpServer started listening with backlog {}.", 128);
+                m_sessionConfig = std::make_shared<const SessionConfig>(config.session);
+                m_maxConnections = config.max_connections;
+                m_listenBacklog = config.listen_backlog;
+                m_acceptConcurrency = std::max<size_t>(1, config.accept_concurrency);
+                m_admission = std::make_unique<AdmissionController>(config.admission);
+                m_handoverPath = config.handover_socket_path;
+                m_handoverSessions = config.handover_sessions;
+                m_handoverDrainTimeout = config.handover_drain_timeout;
 
-                asio::co_spawn(m_ioContext, AcceptLoop(), asio::detached);
+                // Takeover: receive the previous process's sockets before opening anything ourselves
+                std::optional<HandoverChannel> takeoverChannel;
+                std::optional<HandoverPackage> takeover;
+                if (config.takeover && !m_handoverPath.empty())
+                {
+                    takeoverChannel = HandoverChannel::Connect(m_handoverPath);
+                    if (takeoverChannel)
+                    {
+                        takeover = takeoverChannel->ReceivePackage();
+                    }
+                    if (takeover)
+                    {
+                        LOG_INFO("Handover: received {} listening sockets and {} sessions.",
+                                 takeover->listenerFds.size(), takeover->sessions.size());
+                        m_inheritedListeners = std::move(takeover->listenerFds);
+                        takeover->listenerFds.clear();
+                    }
+                    else
+                    {
+                        LOG_WARN("Handover: takeover from '{}' failed, starting with fresh listening sockets.", m_handoverPath);
+                    }
+                }
+                if (m_sessionConfig->read_idle_timeout.count() > 0 || m_sessionConfig->write_stall_timeout.count() > 0)
+                {
+                    // Sessions without a deadline are re-checked within one write-stall timeout
+                    m_sessionReaper = std::make_shared<SessionReaper>(m_ioContext, config.reaper_interval,
+                                                                      m_sessionConfig->write_stall_timeout);
+                    m_sessionReaper->Start();
+                }
 
-                for(int i=0; i<config.worker_threads; ++i)
+                if (config.io_mode == IoMode::PerCore || config.io_mode == IoMode::BusyPoll)
                 {
-                    m_workerThreads.emplace_back([this]()
+                    m_ioContextPool = std::make_unique<IoContextPool>(static_cast<size_t>(config.worker_threads),
+                        config.io_mode == IoMode::BusyPoll ? config.busy_poll_window : std::chrono::microseconds::zero());
+#ifdef BOOST_ASIO_HAS_IO_URING
+                    for (size_t i = 0; i < m_ioContextPool->Size(); ++i)
                     {
-                        m_ioContext.run();
-                    });
-                    LOG_INFO("WorkerThread {} started.", i+1);
+                        m_receivePools.push_back(std::make_shared<RegisteredReceivePool>(
+                            m_ioContextPool->GetContext(i), config.registered_receive_chunks));
+                    }
+#endif
+#ifdef SO_REUSEPORT
+                    if (config.reuse_port)
+                    {
+                        // Kernel spreads incoming connections over one listening socket per context
+                        for (size_t i = 0; i < m_ioContextPool->Size(); ++i)
+                        {
+                            auto& acceptor = *m_acceptors.emplace_back(
+                                std::make_unique<ip::tcp::acceptor>(asio::make_strand(m_ioContextPool->GetContext(i))));
+                            OpenAcceptor(acceptor, true);
+                            SpawnAcceptLoops(acceptor, m_ioContextPool->GetContext(i));
+                        }
+                        AdoptRemainingListeners(true);
+                        LOG_INFO("TcpServer using {} io_contexts with SO_REUSEPORT acceptors.", m_ioContextPool->Size());
+                    }
+                    else
+#endif
+                    {
+                        // Single acceptor on the main context hands sockets to the pool round-robin
+                        OpenAcceptor(m_acceptor, false);
+                        SpawnAcceptLoops(m_acceptor, m_ioContext);
+                        AdoptRemainingListeners(false);
+                        LOG_INFO("TcpServer using {} io_contexts with round-robin session assignment.", m_ioContextPool->Size());
+                    }
+
+                    if (takeover)
+                    {
+                        ResumeSessions(*takeover);
+                        takeoverChannel->SendAck();
+                    }
+                    m_ioContextPool->Run();
+                }
+                else
+                {
+#ifdef BOOST_ASIO_HAS_IO_URING
+                    m_receivePools.push_back(std::make_shared<RegisteredReceivePool>(m_ioContext, config.registered_receive_chunks));
+#endif
+                    OpenAcceptor(m_acceptor, false);
+                    SpawnAcceptLoops(m_acceptor, m_ioContext);
+                    AdoptRemainingListeners(false);
+
+                    if (takeover)
+                    {
+                        ResumeSessions(*takeover);
+                        takeoverChannel->SendAck();
+                    }
+                    for(int i=0; i<config.worker_threads; ++i)
+                    {
+                        m_workerThreads.emplace_back([this]()
+                        {
+                            m_ioContext.run();
+                        });
+                        LOG_INFO("WorkerThread {} started.", i+1);
+                    }
+                }
+
+                if (!m_handoverPath.empty())
+                {
+                    // Ready to hand over to the next deploy in turn
+                    m_handoverListener = HandoverChannel::Listen(m_handoverPath);
+                    if (m_handoverListener)
+                    {
+                        m_handoverThread = std::thread(&TcpServer::HandoverLoop, this);
+                        LOG_INFO("Handover: waiting for a successor on '{}'.", m_handoverPath);
+                    }
                 }
                 return true;
             }
@@ -83,12 +178,29 @@ namespace CppMMO
 
         void TcpServer::Stop()
         {
+            if (m_handoverListener)
+            {
+                m_handoverListener->Shutdown();
+            }
+            if (m_handoverThread.joinable() && m_handoverThread.get_id() != std::this_thread::get_id())
+            {
+                m_handoverThread.join();
+            }
+            if (m_sessionReaper)
+            {
+                m_sessionReaper->Stop();
+            }
             if (!m_ioContext.stopped())
             {
                 m_ioContext.stop();
                 LOG_INFO("TcpServer stopping io_context.");
                 m_ioContext.reset(); // Prepare io_context for reuse
             }
+            if (m_ioContextPool)
+            {
+                m_ioContextPool->Stop();
+                m_ioContextPool->Join();
+            }
             for (std::thread& thread : m_workerThreads)
             {
                 if (thread.joinable())
@@ -112,45 +224,128 @@ namespace CppMMO
             LOG_DEBUG("OnSessionDisconnected callback set.");
         }
 
-        asio::awaitable<void> TcpServer::AcceptLoop()
+        void TcpServer::SetHandoverHandlers(HandoverExportHandler exportState, HandoverImportHandler importState)
+        {
+            m_handoverExport = std::move(exportState);
+            m_handoverImport = std::move(importState);
+        }
+
+        void TcpServer::StopContexts()
+        {
+            m_ioContext.stop();
+            if (m_ioContextPool)
+            {
+                m_ioContextPool->Stop();
+            }
+        }
+
+        void TcpServer::OpenAcceptor(ip::tcp::acceptor& acceptor, bool reusePort)
+        {
+            if (!m_inheritedListeners.empty())
+            {
+                // Keeps the previous process's accept queue, so nothing that connected meanwhile is lost
+                int fd = m_inheritedListeners.front();
+                m_inheritedListeners.erase(m_inheritedListeners.begin());
+                acceptor.assign(ip::tcp::v4(), fd);
+                acceptor.listen(m_listenBacklog);
+                LOG_INFO("TcpServer adopted listening socket on port {} with backlog {}.", m_port, m_listenBacklog);
+                return;
+            }
+
+            ip::tcp::endpoint endpoint(ip::tcp::v4(), m_port);
+            acceptor.open(endpoint.protocol());
+
+            // Enable address reuse to prevent "Address already in use" errors
+            acceptor.set_option(ip::tcp::acceptor::reuse_address(true));
+#ifdef SO_REUSEPORT
+            if (reusePort)
+            {
+                acceptor.set_option(asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true));
+            }
+#else
+            (void)reusePort;
+#endif
+
+            // Disable linger to prevent TIME_WAIT issues
+            boost::asio::socket_base::linger linger_option(false, 0);
+            acceptor.set_option(linger_option);
+
+            acceptor.bind(endpoint);
+            acceptor.listen(m_listenBacklog);
+            LOG_INFO("TcpServer listening on port {} with backlog {}{}.", m_port, m_listenBacklog, reusePort ? " (SO_REUSEPORT)" : "");
+        }
+
+        void TcpServer::SpawnAcceptLoops(ip::tcp::acceptor& acceptor, asio::io_context& context)
+        {
+            // Several outstanding accepts per socket: one readiness event completes all of them.
+            // Acceptors are not safe for concurrent use, so the loops run on the acceptor's strand;
+            // the accept syscalls still happen in the reactor, and session setup is posted off the strand.
+            for (size_t i = 0; i < m_acceptConcurrency; ++i)
+            {
+                asio::co_spawn(acceptor.get_executor(), AcceptLoop(acceptor, context), asio::detached);
+            }
+        }
+
+        void TcpServer::AdoptRemainingListeners(bool onPool)
+        {
+            for (size_t i = 0; !m_inheritedListeners.empty(); ++i)
+            {
+                asio::io_context& context = onPool ? m_ioContextPool->GetContext(i % m_ioContextPool->Size()) : m_ioContext;
+                auto& acceptor = *m_acceptors.emplace_back(std::make_unique<ip::tcp::acceptor>(asio::make_strand(context)));
+                OpenAcceptor(acceptor, true);
+                SpawnAcceptLoops(acceptor, context);
+            }
+        }
+
+        asio::awaitable<void> TcpServer::AcceptLoop(ip::tcp::acceptor& acceptor, asio::io_context& context)
         {
             try
             {
                 while(true)
                 {
-                    ip::tcp::socket socket(m_ioContext);
-                    co_await m_acceptor.async_accept(socket, asio::use_awaitable);
-                    
-                    // Check connection limit to prevent server overload
-                    static constexpr size_t MAX_CONCURRENT_CONNECTIONS = 600;
-                    if (m_sessionManager && m_sessionManager->GetActiveSessionCount() >= MAX_CONCURRENT_CONNECTIONS)
+                    // Per-core mode without SO_REUSEPORT: place the socket on the next pooled context.
+                    // Otherwise the socket stays on the acceptor's own context.
+                    // (The socket gets the context's plain executor, never the acceptor's strand.)
+                    ip::tcp::socket socket = (m_ioContextPool && &context == &m_ioContext)
+                        ? ip::tcp::socket(m_ioContextPool->GetNextContext())
+                        : ip::tcp::socket(context);
+                    ip::tcp::endpoint peer;
+                    co_await acceptor.async_accept(socket, peer, asio::use_awaitable);
+                    ip::address address = peer.address();
+
+                    // Rejections are counted in NetworkStats rather than logged, so a reconnect storm
+                    // costs one accept and one close per connection
+                    AdmissionResult admission = AdmissionResult::Capacity;
+                    if (m_maxConnections == 0 || !m_sessionManager
+                        || m_sessionManager->GetActiveSessionCount() + m_pendingSetups.load(std::memory_order_relaxed) < m_maxConnections)
                     {
-                        LOG_WARN("Connection limit reached ({}). Rejecting new connection from {}", 
-                                MAX_CONCURRENT_CONNECTIONS, socket.remote_endpoint().address().to_string());
-                        socket.close();
-                        continue;
+                        admission = m_admission->Admit(address, Session::SteadyNowMs());
                     }
-                    
-                    // Configure socket options for better connection handling
-                    boost::asio::socket_base::linger linger_option(false, 0);
-                    socket.set_option(linger_option);
-                    socket.set_option(ip::tcp::no_delay(true)); // Disable Nagle algorithm for low latency
-                    
-                    LOG_INFO("New connection accepted from {}", socket.remote_endpoint().address().to_string());
-                    auto session = std::make_shared<Session>(std::move(socket), m_packetManager);
-                    session->SetOnDisconnectedCallback([self = shared_from_this()](std::shared_ptr<ISession> session)
-                    {
-                        self->OnSessionDisconnectedInternal(session);
-                    });
-                    session->Start();
-                    if (m_sessionManager)
+                    NetworkStats::Instance().RecordAdmission(admission);
+                    if (admission != AdmissionResult::Admitted)
                     {
-                        m_sessionManager->AddSession(session);
+                        RejectConnection(socket);
+                        continue;
                     }
-                    if (m_onSessionConnected)
+
+
+                    // Session setup runs as a separate handler on the socket's own context, so this
+                    // loop is back in async_accept straight away and other threads can pick the setup up
+                    m_pendingSetups.fetch_add(1, std::memory_order_relaxed);
+                    auto executor = socket.get_executor();
+                    asio::post(executor, [self = shared_from_this(), socket = std::move(socket), address]() mutable
                     {
-                        m_onSessionConnected(session);
-                    }
+                        // Nothing may escape into io_context::run(); SetupSession releases admission itself
+                        try
+                        {
+                            self->SetupSession(std::move(socket), address);
+                        }
+                        catch (const std::exception& e)
+                        {
+                            LOG_ERROR("Session setup for {} failed: {}", address.to_string(), e.what());
+                        }
+                        self->m_pendingSetups.fetch_sub(1, std::memory_order_relaxed);
+                    });
                 }
             }
             catch (const boost::system::system_error& e)
@@ -171,6 +366,225 @@ namespace CppMMO
             co_return;
         }
 
+        void TcpServer::SetupSession(ip::tcp::socket socket, const ip::address& address)
+        {
+            // Configure socket options for better connection handling
+            boost::system::error_code ec;
+            socket.set_option(asio::socket_base::linger(false, 0), ec);
+            if (!ec)
+            {
+                socket.set_option(ip::tcp::no_delay(true), ec); // Disable Nagle algorithm for low latency
+            }
+            if (ec)
+            {
+                // Peer reset the connection while it waited for setup
+                m_admission->Release(address);
+                return;
+            }
+
+            LOG_INFO("New connection accepted from {}", address.to_string());
+            std::shared_ptr<Session> session;
+            try
+            {
+                session = CreateSession(std::move(socket), address);
+            }
+            catch (...)
+            {
+                // The disconnect callback that would release the slot was never installed
+                m_admission->Release(address);
+                throw;
+            }
+            StartSession(session);
+        }
+
+        std::shared_ptr<Session> TcpServer::CreateSession(ip::tcp::socket socket, const ip::address& address)
+        {
+#ifdef BOOST_ASIO_HAS_IO_URING
+            RegisteredReceivePool* receivePool = FindReceivePool(socket.get_executor());
+#endif
+            auto session = std::make_shared<Session>(std::move(socket), m_packetManager, m_sessionConfig);
+            session->SetOnDisconnectedCallback([self = shared_from_this(), address](std::shared_ptr<ISession> session)
+            {
+                self->m_admission->Release(address);
+                self->OnSessionDisconnectedInternal(session);
+            });
+#ifdef BOOST_ASIO_HAS_IO_URING
+            if (receivePool)
+            {
+                session->UseRegisteredReceiveChunk(receivePool->Acquire());
+            }
+#endif
+            return session;
+        }
+
+        void TcpServer::StartSession(const std::shared_ptr<Session>& session)
+        {
+            session->Start();
+            if (m_sessionReaper)
+            {
+                m_sessionReaper->Add(session);
+            }
+            if (m_sessionManager)
+            {
+                m_sessionManager->AddSession(session);
+            }
+            if (m_onSessionConnected)
+            {
+                m_onSessionConnected(session);
+            }
+        }
+
+        void TcpServer::ResumeSessions(HandoverPackage& package)
+        {
+            std::vector<std::shared_ptr<Session>> sessions;
+            std::unordered_map<uint64_t, uint64_t> sessionByPlayer;
+            for (auto& record : package.sessions)
+            {
+                asio::io_context& context = m_ioContextPool ? m_ioContextPool->GetNextContext() : m_ioContext;
+                ip::tcp::socket socket(context);
+                boost::system::error_code ec;
+                socket.assign(ip::tcp::v4(), std::exchange(record.fd, -1), ec);
+                ip::tcp::endpoint peer = ec ? ip::tcp::endpoint() : socket.remote_endpoint(ec);
+                if (ec)
+                {
+                    // The client went away while the package was in flight
+                    LOG_WARN("Handover: dropping session of player {}: {}", record.playerId, ec.message());
+                    continue;
+                }
+
+                ip::address address = peer.address();
+                m_admission->Adopt(address);
+                auto session = CreateSession(std::move(socket), address);
+                session->Resume(record);
+                if (record.playerId != 0)
+                {
+                    sessionByPlayer[record.playerId] = session->GetSessionId();
+                }
+                sessions.push_back(std::move(session));
+            }
+
+            // World state first, so the first packets read from resumed sessions find their players
+            if (m_handoverImport && !package.gameState.is_null())
+            {
+                m_handoverImport(package.gameState, sessionByPlayer);
+            }
+            for (auto& session : sessions)
+            {
+                StartSession(session);
+            }
+            LOG_INFO("Handover: resumed {} of {} sessions.", sessions.size(), package.sessions.size());
+        }
+
+        void TcpServer::HandoverLoop()
+        {
+            auto successor = m_handoverListener->Accept();
+            if (!successor)
+            {
+                return;     // Stop() shut the listener down
+            }
+            if (PerformHandover(*successor))
+            {
+                LOG_INFO("Handover: successor took over, shutting down.");
+            }
+            else
+            {
+                LOG_CRITICAL("Handover: transfer failed after the listeners were released, shutting down.");
+            }
+            // Either way the listeners are gone from this process, so it cannot keep serving
+            StopContexts();
+        }
+
+        bool TcpServer::PerformHandover(HandoverChannel& channel)
+        {
+            HandoverPackage package;
+
+            // Release each acceptor on its strand, serialized with the accept loops; the pending
+            // async_accepts complete with operation_aborted and the loops end
+            auto release = [&package](ip::tcp::acceptor& acceptor)
+            {
+                std::packaged_task<int()> task([&acceptor]()
+                {
+                    boost::system::error_code ec;
+                    return acceptor.is_open() ? acceptor.release(ec) : -1;
+                });
+                auto result = task.get_future();
+                asio::post(acceptor.get_executor(), std::move(task));
+                int fd = result.get();
+                if (fd >= 0)
+                {
+                    package.listenerFds.push_back(fd);
+                }
+            };
+            release(m_acceptor);
+            for (auto& acceptor : m_acceptors)
+            {
+                release(*acceptor);
+            }
+            LOG_INFO("Handover: released {} listening sockets.", package.listenerFds.size());
+
+            if (m_handoverExport)
+            {
+                package.gameState = m_handoverExport();
+            }
+
+            if (m_handoverSessions && m_sessionManager)
+            {
+                std::vector<std::future<HandoverSession>> detached;
+                for (auto& session : m_sessionManager->GetAllSessions())
+                {
+                    auto concrete = std::dynamic_pointer_cast<Session>(session);
+                    if (concrete)
+                    {
+                        detached.push_back(asio::co_spawn(concrete->GetExecutor(),
+                            concrete->Detach(m_handoverDrainTimeout), asio::use_future));
+                    }
+                }
+                for (auto& result : detached)
+                {
+                    try
+                    {
+                        HandoverSession record = result.get();
+                        if (record.fd >= 0)
+                        {
+                            package.sessions.push_back(std::move(record));
+                        }
+                    }
+                    catch (const std::exception& e)
+                    {
+                        LOG_WARN("Handover: session detach failed: {}", e.what());
+                    }
+                }
+                LOG_INFO("Handover: detached {} of {} sessions.", package.sessions.size(), detached.size());
+            }
+
+            bool delivered = channel.SendPackage(package) && channel.WaitAck(HANDOVER_ACK_TIMEOUT);
+            // The successor holds its own duplicates now; on failure closing ours disconnects the clients
+            package.CloseAll();
+            return delivered;
+        }
+
+#ifdef BOOST_ASIO_HAS_IO_URING
+        RegisteredReceivePool* TcpServer::FindReceivePool(const asio::any_io_executor& executor) const
+        {
+            for (const auto& pool : m_receivePools)
+            {
+                if (&pool->GetContext() == &executor.context())
+                {
+                    return pool.get();
+                }
+            }
+            return nullptr;
+        }
+#endif
+
+        void TcpServer::RejectConnection(ip::tcp::socket& socket)
+        {
+            // SO_LINGER with a zero timeout makes close() send RST and free the socket immediately
+            boost::system::error_code ec;
+            socket.set_option(asio::socket_base::linger(true, 0), ec);
+            socket.close(ec);
+        }
+
         void TcpServer::OnSessionDisconnectedInternal(std::shared_ptr<ISession> session)
         {
             LOG_INFO("Session disconnected.");
@@ -4,6 +4,10 @@
 #include "IPacketManager.h" 
 #include "ISessionManager.h"
 #include "Session.h"
+#include "IoContextPool.h"
+#include "SessionReaper.h"
+#include "AdmissionController.h"
+#include "SocketHandover.h"
 
 namespace asio = boost::asio;
 namespace ip = boost::asio::ip;
@@ -28,18 +32,71 @@ namespace CppMMO
             virtual void SetOnSessionConnected(const std::function<void(std::shared_ptr<ISession>)>& callback) override;
             virtual void SetOnSessionDisconnected(const std::function<void(std::shared_ptr<ISession>)>& callback) override;
 
+            using HandoverExportHandler = std::function<nlohmann::json()>;
+            using HandoverImportHandler = std::function<void(const nlohmann::json& gameState,
+                                                             const std::unordered_map<uint64_t, uint64_t>& sessionByPlayer)>;
+            // Game state carried across a socket handover. `exportState` runs in the old process once
+            // its listeners are released and must stop everything that sends; `importState` runs in
+            // the new one before the resumed sessions start. Call before Start().
+            void SetHandoverHandlers(HandoverExportHandler exportState, HandoverImportHandler importState);
+
         private:
             asio::io_context& m_ioContext;
+            unsigned short m_port;
+            // Declared before the session manager so pooled sockets are closed before their contexts go away
+            std::unique_ptr<IoContextPool> m_ioContextPool;
+            // Listening sockets besides m_acceptor: the SO_REUSEPORT group, plus any extra ones inherited in a handover
+            std::vector<std::unique_ptr<asio::ip::tcp::acceptor>> m_acceptors;
+#ifdef BOOST_ASIO_HAS_IO_URING
+            // One registered receive arena per io_context (registration belongs to the ring)
+            std::vector<std::shared_ptr<RegisteredReceivePool>> m_receivePools;   // Shared with the chunks sessions hold
+            RegisteredReceivePool* FindReceivePool(const asio::any_io_executor& executor) const;
+#endif
             asio::ip::tcp::acceptor m_acceptor;
             std::shared_ptr<IPacketManager> m_packetManager;
             std::shared_ptr<ISessionManager> m_sessionManager;
+            std::shared_ptr<const SessionConfig> m_sessionConfig;   // Shared by all sessions
+            size_t m_maxConnections = 0;
+            int m_listenBacklog = 1024;
+            size_t m_acceptConcurrency = 1;
+            std::atomic<size_t> m_pendingSetups{0};     // Admitted, setup handler not run yet; counts toward max_connections
+            std::unique_ptr<AdmissionController> m_admission;
+            std::shared_ptr<SessionReaper> m_sessionReaper;
 
             std::function<void(std::shared_ptr<ISession>)> m_onSessionConnected{};
             std::function<void(std::shared_ptr<ISession>)> m_onSessionDisconnected{};
 
+            // Socket handover to a replacement process
+            std::string m_handoverPath;
+            bool m_handoverSessions = true;
+            std::chrono::milliseconds m_handoverDrainTimeout{500};
+            std::vector<int> m_inheritedListeners;              // Adopted by OpenAcceptor in order
+            std::optional<HandoverChannel> m_handoverListener;
+            std::thread m_handoverThread;
+            HandoverExportHandler m_handoverExport;
+            HandoverImportHandler m_handoverImport;
+            static constexpr std::chrono::seconds HANDOVER_ACK_TIMEOUT{10};
+
             std::vector<std::thread> m_workerThreads;
             asio::signal_set m_signals;
-            asio::awaitable<void> AcceptLoop();
+            void OpenAcceptor(asio::ip::tcp::acceptor& acceptor, bool reusePort);
+            // Starts accept loops for inherited listening sockets that OpenAcceptor did not use
+            void AdoptRemainingListeners(bool onPool);
+            void SpawnAcceptLoops(asio::ip::tcp::acceptor& acceptor, asio::io_context& context);
+            asio::awaitable<void> AcceptLoop(asio::ip::tcp::acceptor& acceptor, asio::io_context& context);
+            // Socket options, Session construction and the connect callbacks, off the accept path
+            void SetupSession(asio::ip::tcp::socket socket, const asio::ip::address& address);
+            std::shared_ptr<Session> CreateSession(asio::ip::tcp::socket socket, const asio::ip::address& address);
+            void StartSession(const std::shared_ptr<Session>& session);
+
+            // New process: sessions received from the previous one, started after the game state is imported
+            void ResumeSessions(HandoverPackage& package);
+            // Old process: waits for the next process and hands everything over, then stops this one
+            void HandoverLoop();
+            bool PerformHandover(HandoverChannel& channel);
+            void StopContexts();
+            // Resets a connection that failed admission without a TIME_WAIT entry or a log line
+            static void RejectConnection(asio::ip::tcp::socket& socket);
             void OnSessionDisconnectedInternal(std::shared_ptr<ISession> session);
         };
     }
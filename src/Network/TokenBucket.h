@@ -0,0 +1,57 @@
+#pragma once
+#include "pch.h"
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        /**
+         * @brief Token bucket refilled lazily from a caller-supplied millisecond clock.
+         *
+         * Not thread-safe; owners either use it from one thread or guard it. A default-constructed
+         * bucket is disabled and callers skip it.
+         */
+        class TokenBucket
+        {
+        public:
+            TokenBucket() = default;
+            TokenBucket(double ratePerSecond, double burst)
+                : m_ratePerMs(ratePerSecond / 1000.0),
+                  m_burst(std::max(burst, 1.0)),
+                  m_tokens(std::max(burst, 1.0))
+            {
+            }
+
+            bool Enabled() const { return m_ratePerMs > 0.0; }
+
+            // Refills for the time since the last call and reports whether `cost` tokens are available
+            bool HasTokens(double cost, int64_t nowMs)
+            {
+                if (m_lastRefillMs == 0)
+                {
+                    m_lastRefillMs = nowMs;
+                }
+                else if (nowMs > m_lastRefillMs)
+                {
+                    m_tokens = std::min(m_burst, m_tokens + (nowMs - m_lastRefillMs) * m_ratePerMs);
+                    m_lastRefillMs = nowMs;
+                }
+                return m_tokens >= cost;
+            }
+
+            void Take(double cost) { m_tokens -= cost; }
+
+            // True once the bucket would be back to full burst at `nowMs`, i.e. it carries no history
+            bool IsFull(int64_t nowMs) const
+            {
+                return m_tokens + (nowMs - m_lastRefillMs) * m_ratePerMs >= m_burst;
+            }
+
+        private:
+            double m_ratePerMs = 0.0;
+            double m_burst = 0.0;
+            double m_tokens = 0.0;
+            int64_t m_lastRefillMs = 0;
+        };
+    }
+}
@@ -0,0 +1,321 @@
+#include "pch.h"
+#include "UdpChannel.h"
+#include "NetworkStats.h"
+
+#include <random>
+
+#ifdef __linux__
+#include <sys/random.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <cerrno>
+#endif
+
+namespace asio = boost::asio;
+namespace ip = boost::asio::ip;
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        namespace
+        {
+            // The token is the only thing proving a datagram's sender is the logged-in client, so it
+            // comes from the OS CSPRNG rather than a seeded PRNG whose output can be predicted
+            uint64_t GenerateToken()
+            {
+                uint64_t token = 0;
+#ifdef __linux__
+                auto* out = reinterpret_cast<unsigned char*>(&token);
+                size_t filled = 0;
+                while (filled < sizeof(token))
+                {
+                    ssize_t got = ::getrandom(out + filled, sizeof(token) - filled, 0);
+                    if (got < 0)
+                    {
+                        if (errno == EINTR) continue;
+                        break;
+                    }
+                    filled += static_cast<size_t>(got);
+                }
+                if (filled == sizeof(token))
+                {
+                    return token;
+                }
+#endif
+                std::random_device device;
+                token = (static_cast<uint64_t>(device()) << 32) | device();
+                return token;
+            }
+        }
+
+        UdpChannel::UdpChannel(asio::io_context& ioContext, unsigned short port, size_t maxDatagramBytes)
+            : m_ioContext(ioContext),
+              m_socket(ioContext),
+              m_port(port),
+              m_maxDatagramBytes(maxDatagramBytes)
+        {
+        }
+
+        UdpChannel::~UdpChannel()
+        {
+            Stop();
+        }
+
+        bool UdpChannel::Start()
+        {
+            try
+            {
+                m_socket.open(ip::udp::v4());
+                m_socket.set_option(ip::udp::socket::reuse_address(true));
+                m_socket.bind(ip::udp::endpoint(ip::udp::v4(), m_port));
+                // Flush() runs on the game loop thread and must never block on a full send buffer
+                m_socket.non_blocking(true);
+
+                asio::co_spawn(m_ioContext, ReceiveLoop(), asio::detached);
+                LOG_INFO("UdpChannel listening on port {} (max datagram {} bytes).", m_port, m_maxDatagramBytes);
+                return true;
+            }
+            catch (const boost::system::system_error& e)
+            {
+                LOG_ERROR("UdpChannel Start failed: {}", e.what());
+                return false;
+            }
+        }
+
+        void UdpChannel::Stop()
+        {
+            if (m_socket.is_open())
+            {
+                boost::system::error_code ec;
+                m_socket.close(ec);
+            }
+        }
+
+        uint64_t UdpChannel::RegisterSession(uint64_t sessionId)
+        {
+            std::lock_guard<std::mutex> lock(m_bindingMutex);
+
+            auto existing = m_bindings.find(sessionId);
+            if (existing != m_bindings.end())
+            {
+                m_tokens.erase(existing->second.token);
+            }
+
+            uint64_t token = 0;
+            do
+            {
+                token = GenerateToken();
+            } while (token == 0 || m_tokens.contains(token));
+
+            m_tokens[token] = sessionId;
+            m_bindings[sessionId] = Binding{token, false, {}};
+            return token;
+        }
+
+        void UdpChannel::UnregisterSession(uint64_t sessionId)
+        {
+            std::lock_guard<std::mutex> lock(m_bindingMutex);
+            auto it = m_bindings.find(sessionId);
+            if (it != m_bindings.end())
+            {
+                m_tokens.erase(it->second.token);
+                m_bindings.erase(it);
+            }
+        }
+
+        bool UdpChannel::QueueSnapshot(uint64_t sessionId, uint64_t tickNumber, std::span<const std::byte> packet)
+        {
+            if (HEADER_SIZE + packet.size() > m_maxDatagramBytes)
+            {
+                return false;
+            }
+
+            ip::udp::endpoint endpoint;
+            {
+                std::lock_guard<std::mutex> lock(m_bindingMutex);
+                auto it = m_bindings.find(sessionId);
+                if (it == m_bindings.end() || !it->second.bound)
+                {
+                    return false;
+                }
+                endpoint = it->second.endpoint;
+            }
+
+            size_t offset = m_sendArena.size();
+            m_sendArena.resize(offset + HEADER_SIZE + packet.size());
+            std::memcpy(m_sendArena.data() + offset, &tickNumber, HEADER_SIZE);
+            std::memcpy(m_sendArena.data() + offset + HEADER_SIZE, packet.data(), packet.size());
+            m_pending.push_back(PendingDatagram{endpoint, offset, HEADER_SIZE + packet.size()});
+            return true;
+        }
+
+        void UdpChannel::Flush()
+        {
+            if (m_pending.empty())
+            {
+                return;
+            }
+
+            size_t sent = 0;
+            size_t sendCalls = 0;
+            size_t sentBytes = 0;
+
+#ifdef __linux__
+            std::array<mmsghdr, BATCH_SIZE> headers{};
+            std::array<iovec, BATCH_SIZE> iovecs{};
+
+            while (sent < m_pending.size() && m_socket.is_open())
+            {
+                size_t count = std::min(BATCH_SIZE, m_pending.size() - sent);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    auto& datagram = m_pending[sent + i];
+                    iovecs[i].iov_base = m_sendArena.data() + datagram.offset;
+                    iovecs[i].iov_len = datagram.size;
+                    headers[i] = mmsghdr{};
+                    headers[i].msg_hdr.msg_name = datagram.endpoint.data();
+                    headers[i].msg_hdr.msg_namelen = static_cast<socklen_t>(datagram.endpoint.size());
+                    headers[i].msg_hdr.msg_iov = &iovecs[i];
+                    headers[i].msg_hdr.msg_iovlen = 1;
+                }
+
+                int result = ::sendmmsg(m_socket.native_handle(), headers.data(), static_cast<unsigned int>(count), 0);
+                if (result < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                ++sendCalls;
+                if (result <= 0)
+                {
+                    // Send buffer full (or a hard error): the rest of this tick is dropped, the next tick supersedes it
+                    if (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+                    {
+                        LOG_WARN("UdpChannel: sendmmsg failed: {}", std::strerror(errno));
+                    }
+                    break;
+                }
+                for (int i = 0; i < result; ++i)
+                {
+                    sentBytes += m_pending[sent + i].size;
+                }
+                sent += static_cast<size_t>(result);
+            }
+#else
+            for (const auto& datagram : m_pending)
+            {
+                boost::system::error_code ec;
+                m_socket.send_to(asio::buffer(m_sendArena.data() + datagram.offset, datagram.size), datagram.endpoint, 0, ec);
+                ++sendCalls;
+                if (ec)
+                {
+                    break;
+                }
+                sentBytes += datagram.size;
+                ++sent;
+            }
+#endif
+
+            NetworkStats::Instance().RecordUdpSend(sent, sendCalls, sentBytes, m_pending.size() - sent);
+            m_pending.clear();
+            m_sendArena.clear();
+        }
+
+        asio::awaitable<void> UdpChannel::ReceiveLoop()
+        {
+#ifdef __linux__
+            // Pairing datagrams are only a token; anything larger is truncated and ignored
+            std::array<std::array<std::byte, 64>, BATCH_SIZE> buffers;
+            std::array<sockaddr_storage, BATCH_SIZE> addresses;
+            std::array<iovec, BATCH_SIZE> iovecs;
+            std::array<mmsghdr, BATCH_SIZE> headers;
+
+            while (m_socket.is_open())
+            {
+                auto [error] = co_await m_socket.async_wait(ip::udp::socket::wait_read, asio::as_tuple(asio::use_awaitable));
+                if (error)
+                {
+                    co_return;
+                }
+
+                for (;;)
+                {
+                    for (size_t i = 0; i < BATCH_SIZE; ++i)
+                    {
+                        iovecs[i].iov_base = buffers[i].data();
+                        iovecs[i].iov_len = buffers[i].size();
+                        headers[i] = mmsghdr{};
+                        headers[i].msg_hdr.msg_name = &addresses[i];
+                        headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+                        headers[i].msg_hdr.msg_iov = &iovecs[i];
+                        headers[i].msg_hdr.msg_iovlen = 1;
+                    }
+
+                    int count = ::recvmmsg(m_socket.native_handle(), headers.data(), BATCH_SIZE, MSG_DONTWAIT, nullptr);
+                    if (count <= 0)
+                    {
+                        break;
+                    }
+
+                    for (int i = 0; i < count; ++i)
+                    {
+                        ip::udp::endpoint sender;
+                        std::memcpy(sender.data(), &addresses[i], headers[i].msg_hdr.msg_namelen);
+                        sender.resize(headers[i].msg_hdr.msg_namelen);
+                        HandleBind(buffers[i].data(), headers[i].msg_len, sender);
+                    }
+
+                    if (static_cast<size_t>(count) < BATCH_SIZE)
+                    {
+                        break;
+                    }
+                }
+            }
+#else
+            std::array<std::byte, 64> buffer;
+            ip::udp::endpoint sender;
+            while (m_socket.is_open())
+            {
+                auto [error, bytes] = co_await m_socket.async_receive_from(asio::buffer(buffer), sender,
+                    asio::as_tuple(asio::use_awaitable));
+                if (error == asio::error::operation_aborted || !m_socket.is_open())
+                {
+                    co_return;
+                }
+                if (!error)
+                {
+                    HandleBind(buffer.data(), bytes, sender);
+                }
+            }
+#endif
+        }
+
+        void UdpChannel::HandleBind(const std::byte* data, size_t size, const ip::udp::endpoint& sender)
+        {
+            if (size != TOKEN_SIZE)
+            {
+                return;
+            }
+
+            uint64_t token = 0;
+            std::memcpy(&token, data, TOKEN_SIZE);
+
+            std::lock_guard<std::mutex> lock(m_bindingMutex);
+            auto tokenIt = m_tokens.find(token);
+            if (tokenIt == m_tokens.end())
+            {
+                LOG_DEBUG("UdpChannel: Ignoring datagram with unknown token from {}", sender.address().to_string());
+                return;
+            }
+
+            auto& binding = m_bindings[tokenIt->second];
+            if (!binding.bound || binding.endpoint != sender)
+            {
+                // Rebinding follows the client across NAT port changes
+                LOG_INFO("UdpChannel: Session {} bound to {}:{}", tokenIt->second, sender.address().to_string(), sender.port());
+                binding.endpoint = sender;
+                binding.bound = true;
+            }
+        }
+    }
+}
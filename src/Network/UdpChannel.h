@@ -0,0 +1,88 @@
+#pragma once
+#include "pch.h"
+
+namespace CppMMO
+{
+    namespace Network
+    {
+        /**
+         * @brief Optional unreliable side channel that carries S_WorldSnapshot over UDP.
+         *
+         * A session is paired at login: S_LoginSuccess hands the client a random token and the
+         * client sends that token from its UDP socket. From then on the per-tick snapshot is sent as
+         * a datagram instead of through the TCP write queue, so a lost snapshot is superseded by the
+         * next tick instead of holding back everything queued behind it.
+         *
+         * Datagram layout (little-endian):
+         *   client -> server: uint64 token, resent periodically to keep NAT mappings alive
+         *   server -> client: uint64 tick number followed by the UnifiedPacket bytes
+         * Clients drop any datagram whose tick is not newer than the last one they applied.
+         *
+         * Snapshots queued during a tick are written at the end of the tick with one sendmmsg call
+         * per BATCH_SIZE datagrams; pairing datagrams are drained with recvmmsg.
+         */
+        class UdpChannel
+        {
+        public:
+            UdpChannel(boost::asio::io_context& ioContext, unsigned short port, size_t maxDatagramBytes);
+            ~UdpChannel();
+
+            UdpChannel(const UdpChannel&) = delete;
+            UdpChannel& operator=(const UdpChannel&) = delete;
+
+            bool Start();
+            void Stop();
+
+            // Creates a pairing token; the session keeps receiving snapshots over TCP until the client binds.
+            uint64_t RegisterSession(uint64_t sessionId);
+            void UnregisterSession(uint64_t sessionId);
+
+            /**
+             * @brief Queues a snapshot datagram for the next Flush().
+             * @return false if the session is not bound or the packet does not fit in one datagram;
+             *         the caller sends it over TCP instead.
+             */
+            bool QueueSnapshot(uint64_t sessionId, uint64_t tickNumber, std::span<const std::byte> packet);
+
+            // Sends everything queued since the previous call. Game loop thread only.
+            void Flush();
+
+            unsigned short GetPort() const { return m_port; }
+
+        private:
+            static constexpr size_t TOKEN_SIZE = sizeof(uint64_t);
+            static constexpr size_t HEADER_SIZE = sizeof(uint64_t);
+            static constexpr size_t BATCH_SIZE = 64;
+
+            struct Binding
+            {
+                uint64_t token = 0;
+                bool bound = false;
+                boost::asio::ip::udp::endpoint endpoint;
+            };
+
+            struct PendingDatagram
+            {
+                boost::asio::ip::udp::endpoint endpoint;
+                size_t offset = 0;
+                size_t size = 0;
+            };
+
+            boost::asio::awaitable<void> ReceiveLoop();
+            void HandleBind(const std::byte* data, size_t size, const boost::asio::ip::udp::endpoint& sender);
+
+            boost::asio::io_context& m_ioContext;
+            boost::asio::ip::udp::socket m_socket;
+            unsigned short m_port;
+            size_t m_maxDatagramBytes;
+
+            std::mutex m_bindingMutex;
+            std::unordered_map<uint64_t, Binding> m_bindings;   // session id -> binding
+            std::unordered_map<uint64_t, uint64_t> m_tokens;    // token -> session id
+
+            // Datagrams of the current tick; touched only by the game loop thread
+            std::vector<std::byte> m_sendArena;
+            std::vector<PendingDatagram> m_pending;
+        };
+    }
+}
@@ -1,4 +1,5 @@
 #include "JobProcessor.h"
+#include "Network/NetworkStats.h"
 
 namespace CppMMO
 {
@@ -39,9 +40,14 @@ namespace CppMMO
             }
             m_running.store(true, std::memory_order_release);
 
+            if (m_jobQueue->GetShardCount() > 1 && static_cast<size_t>(numThreads) != m_jobQueue->GetShardCount())
+            {
+                LOG_WARN("JobProcessor: {} workers for {} job shards; workers sharing a shard lose per-session ordering.",
+                         numThreads, m_jobQueue->GetShardCount());
+            }
             for(int i=0; i< numThreads; ++i)
             {
-                m_workerThreads.emplace_back(&JobProcessor::WorkerLoop, this);
+                m_workerThreads.emplace_back(&JobProcessor::WorkerLoop, this, static_cast<size_t>(i));
                 LOG_INFO("JobProcessor worker thread {} started.", i+1);
             }
         }
@@ -58,6 +64,8 @@ namespace CppMMO
                 shutdownJob.isShutdownSignal = true;
                 m_jobQueue->PushJob(std::move(shutdownJob));
             }
+            // A worker whose signal was stolen by a neighbour still wakes up and exits
+            m_jobQueue->Shutdown();
             for (std::thread& thread : m_workerThreads)
             {
                 if (thread.joinable())
@@ -69,13 +77,13 @@ namespace CppMMO
             LOG_INFO("JobProcessor stopped and all worker threads joined.");
         }
 
-        void JobProcessor::WorkerLoop()
+        void JobProcessor::WorkerLoop(size_t index)
         {
             while (true)
             {
-                Job job = m_jobQueue->PopJob();
+                Job job = m_jobQueue->PopJob(index);
 
-                if (job.isShutdownSignal)
+                if (job.isShutdownSignal || (!job.session && m_jobQueue->IsShuttingDown()))
                 {
                     LOG_INFO("JobProcessor worker thread received shutdown signal and is exiting.");
                     break;
@@ -112,7 +120,11 @@ namespace CppMMO
                         continue;
                     }
                     const Protocol::UnifiedPacket* unifiedPacket = Protocol::GetUnifiedPacket(packetData);
+                    Network::NetworkStats::Instance().RecordJobDispatch(job.session->MarkPacketDispatched(job.sequence));
                     ProcessJobPacket(job, unifiedPacket);
+
+                    // Dispatch is done with the raw bytes; hand the slab back to the pool right away
+                    job.packetBuffer.Reset();
                 }
                 catch(const std::exception& e)
                 {
@@ -133,6 +145,7 @@ namespace CppMMO
                 case Protocol::PacketId_S_LoginFailure:
                 case Protocol::PacketId_C_Chat:
                 case Protocol::PacketId_S_Chat:
+                case Protocol::PacketId_C_Heartbeat:
                     isNonGamePacket = true;
                     break;
                 default:
@@ -151,62 +164,63 @@ namespace CppMMO
             }
             else
             {
-                if(m_gameLogicQueue)
-                {
-                    Game::GameCommand gameCommand;
-                    gameCommand.commandId = 0;
-                    gameCommand.senderSessionId = job.session->GetSessionId();
+                PushGameCommand(job.session, unifiedPacket, job.receivedAtUs);
+            }
+        }
+
+        void JobProcessor::PushGameCommand(const std::shared_ptr<Network::ISession>& session, const Protocol::UnifiedPacket* unifiedPacket,
+                                           int64_t receivedAtUs)
+        {
+            if (!m_gameLogicQueue)
+            {
+                LOG_ERROR("GameLogicQueue is null in JobProcessor. Cannot push in-game packet.");
+                return;
+            }
+            Protocol::PacketId packetId = unifiedPacket->id();
+            Game::CompactGameCommand command;
+            command.sessionId = session->GetSessionId();
+            command.playerId = session->GetPlayerId();
+            command.receivedAtUs = receivedAtUs;
 
-                    switch (packetId)
+            switch (packetId)
+            {
+                case Protocol::PacketId_C_PlayerInput:
+                {
+                    const Protocol::C_PlayerInput* c_player_input_packet = static_cast<const Protocol::C_PlayerInput*>(unifiedPacket->data());
+                    if (c_player_input_packet)
                     {
-                        case Protocol::PacketId_C_PlayerInput:
-                        {
-                            const Protocol::C_PlayerInput* c_player_input_packet = static_cast<const Protocol::C_PlayerInput*>(unifiedPacket->data());
-                            if (c_player_input_packet)
-                            {
-                                Game::PlayerInputCommandData playerInputCommandData;
-                                playerInputCommandData.playerId = job.session->GetPlayerId();
-                                playerInputCommandData.inputFlags = c_player_input_packet->input_flags();
-                                playerInputCommandData.sequenceNumber = c_player_input_packet->sequence_number();
-                                gameCommand.payload = playerInputCommandData;
-                                m_gameLogicQueue->PushGameCommand(std::move(gameCommand));
-                                LOG_DEBUG("In-game PacketId {} (C_PlayerInput) pushed to GameLogicQueue. InputFlags: {}, Seq: {}", static_cast<int>(packetId), c_player_input_packet->input_flags(), c_player_input_packet->sequence_number());
-                            }
-                            else
-                            {
-                                LOG_ERROR("Failed to get C_PlayerInput packet data from UnifiedPacket in JobProcessor.");
-                            }
-                            break;
-                        }
-                        case Protocol::PacketId_C_EnterZone:
-                        {
-                            const Protocol::C_EnterZone* c_enter_zone_packet = static_cast<const Protocol::C_EnterZone*>(unifiedPacket->data());
-                            if (c_enter_zone_packet)
-                            {
-                                Game::EnterZoneCommandData enterZoneCommandData;
-                                enterZoneCommandData.playerId = job.session->GetPlayerId();
-                                enterZoneCommandData.zoneId = c_enter_zone_packet->zone_id();
-                                enterZoneCommandData.sessionId = job.session->GetSessionId();
-                                gameCommand.payload = enterZoneCommandData;
-                                m_gameLogicQueue->PushGameCommand(std::move(gameCommand));
-                                LOG_DEBUG("In-game PacketId {} (C_EnterZone) pushed to GameLogicQueue.", static_cast<int>(packetId));
-                            }
-                            else
-                            {
-                                LOG_ERROR("Failed to get C_EnterZone packet data from UnifiedPacket in JobProcessor.");
-                            }
-                            break;
-                        }
-                        default:
-                        {
-                            LOG_WARN("Unhandled in-game PacketId {} in JobProcessor. No GameCommand created.", static_cast<int>(packetId));
-                            break;
-                        }
+                        command.type = Game::CompactCommandType::PlayerInput;
+                        command.inputFlags = c_player_input_packet->input_flags();
+                        command.sequenceNumber = c_player_input_packet->sequence_number();
+                        m_gameLogicQueue->PushCompactCommand(command);
+                        LOG_DEBUG("In-game PacketId {} (C_PlayerInput) pushed to GameLogicQueue. InputFlags: {}, Seq: {}", static_cast<int>(packetId), c_player_input_packet->input_flags(), c_player_input_packet->sequence_number());
+                    }
+                    else
+                    {
+                        LOG_ERROR("Failed to get C_PlayerInput packet data from UnifiedPacket for GameCommand.");
                     }
+                    break;
                 }
-                else
+                case Protocol::PacketId_C_EnterZone:
+                {
+                    const Protocol::C_EnterZone* c_enter_zone_packet = static_cast<const Protocol::C_EnterZone*>(unifiedPacket->data());
+                    if (c_enter_zone_packet)
+                    {
+                        command.type = Game::CompactCommandType::EnterZone;
+                        command.zoneId = c_enter_zone_packet->zone_id();
+                        m_gameLogicQueue->PushCompactCommand(command);
+                        LOG_DEBUG("In-game PacketId {} (C_EnterZone) pushed to GameLogicQueue.", static_cast<int>(packetId));
+                    }
+                    else
+                    {
+                        LOG_ERROR("Failed to get C_EnterZone packet data from UnifiedPacket for GameCommand.");
+                    }
+                    break;
+                }
+                default:
                 {
-                    LOG_ERROR("GameLogicQueue is null in JobProcessor. Cannot push in-game packet.");
+                    LOG_WARN("Unhandled in-game PacketId {} for GameCommand. No GameCommand created.", static_cast<int>(packetId));
+                    break;
                 }
             }
         }
@@ -20,6 +20,11 @@ namespace CppMMO
             void Start(int numThreads);
             void Stop();
 
+            // Turns a verified in-game packet into a GameCommand on the GameLogicQueue. Called by the
+            // workers and, for packets registered as inline handlers, directly on the I/O thread.
+            void PushGameCommand(const std::shared_ptr<Network::ISession>& session, const Protocol::UnifiedPacket* unifiedPacket,
+                                 int64_t receivedAtUs);
+
         private:
             std::shared_ptr<JobQueue> m_jobQueue;
             std::shared_ptr<Network::IPacketManager> m_packetManager;
@@ -28,7 +33,8 @@ namespace CppMMO
             std::vector<std::thread> m_workerThreads{};
             std::atomic<bool> m_running = false;
 
-            void WorkerLoop();
+            // `index` selects the worker's own JobQueue shard
+            void WorkerLoop(size_t index);
             void ProcessJobPacket(const Job& job, const Protocol::UnifiedPacket* unifiedPacket);
         };
     }
@@ -1,13 +1,25 @@
 #include "JobQueue.h"
+#include "Network/NetworkStats.h"
 
 namespace CppMMO
 {
     namespace Utils
     {
         static constexpr size_t DEFAULT_QUEUE_CAPACITY = 1024;
+
+        JobQueue::Shard::Shard(const WaitConfig& waitConfig) : jobs(DEFAULT_QUEUE_CAPACITY), waiter(waitConfig)
+        {
+        }
         
-        JobQueue::JobQueue() : m_jobQueue(DEFAULT_QUEUE_CAPACITY)
+        JobQueue::JobQueue(const WaitConfig& waitConfig, size_t shardCount, size_t stealThreshold)
+            : m_stealThreshold(stealThreshold)
         {
+            shardCount = std::max<size_t>(1, shardCount);
+            m_shards.reserve(shardCount);
+            for (size_t i = 0; i < shardCount; ++i)
+            {
+                m_shards.push_back(std::make_unique<Shard>(waitConfig));
+            }
         }
 
         void JobQueue::PushJob(Job job)
@@ -17,36 +29,59 @@ namespace CppMMO
                 LOG_WARN("Attempted to push job to a shutting down queue.");
                 return;
             }
-            m_jobQueue.enqueue(std::move(job));
+            size_t index = job.session
+                ? job.session->GetSessionId() % m_shards.size()
+                : m_nextUnowned.fetch_add(1, std::memory_order_relaxed) % m_shards.size();
+            Shard& shard = *m_shards[index];
+            shard.jobs.enqueue(std::move(job));
+            shard.waiter.Notify();
 
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_condition.notify_one();
+            // Backed up: give a neighbour that may be parked the chance to steal
+            if (m_stealThreshold > 0 && m_shards.size() > 1 && shard.jobs.size_approx() > m_stealThreshold)
+            {
+                m_shards[(index + 1) % m_shards.size()]->waiter.Notify();
+            }
         }
 
-        Job JobQueue::PopJob()
+        bool JobQueue::TrySteal(size_t owner, Job& job)
         {
-            Job job;
-            std::unique_lock<std::mutex> lock(m_mutex);
-
-            m_condition.wait(lock, [this, &job]
+            for (size_t offset = 1; offset < m_shards.size(); ++offset)
             {
-                return m_jobQueue.try_dequeue(job) || m_shuttingDown.load(std::memory_order_acquire);
-            });
+                Shard& victim = *m_shards[(owner + offset) % m_shards.size()];
+                if (victim.jobs.size_approx() > m_stealThreshold && victim.jobs.try_dequeue(job))
+                {
+                    Network::NetworkStats::Instance().RecordJobSteal();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        Job JobQueue::PopJob(size_t worker)
+        {
+            size_t owner = worker % m_shards.size();
+            Shard& shard = *m_shards[owner];
+            bool canSteal = m_stealThreshold > 0 && m_shards.size() > 1;
 
-            if(m_shuttingDown.load(std::memory_order_acquire) && !m_jobQueue.try_dequeue(job))
+            Job job;
+            auto tryPop = [&]
+            {
+                return shard.jobs.try_dequeue(job) || (canSteal && TrySteal(owner, job));
+            };
+            if (!shard.waiter.Wait(tryPop, m_shuttingDown))
             {
                 return Job{};
             }
-
             return job;
         }
 
         void JobQueue::Shutdown()
         {
             m_shuttingDown.store(true, std::memory_order_release);
-
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_condition.notify_all();
+            for (auto& shard : m_shards)
+            {
+                shard->waiter.NotifyAll();
+            }
         }
     }
-}
\ No newline at end of file
+}
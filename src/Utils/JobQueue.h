@@ -1,6 +1,8 @@
 #pragma once
 #include "pch.h"
 #include "Network/ISession.h"
+#include "Utils/MemoryPool.h"
+#include "Utils/QueueWaiter.h"
 #include "protocol_generated.h"
 
 namespace CppMMO
@@ -10,16 +12,20 @@ namespace CppMMO
         struct Job
         {
             std::shared_ptr<Network::ISession> session;
-            std::vector<std::byte> packetBuffer;
+            PooledPacketBuffer packetBuffer;
+            uint32_t sequence = 0;      // Per-session order, see ISession::NextPacketSequence
+            int64_t receivedAtUs = 0;   // Steady clock when the I/O thread read the packet
             bool isShutdownSignal = false;
             
-            // Move constructor to avoid vector copying
+            // Move constructor to hand the pooled buffer over without copying
             Job() = default;
-            Job(std::shared_ptr<Network::ISession> sess, std::vector<std::byte>&& buffer)
+            Job(std::shared_ptr<Network::ISession> sess, PooledPacketBuffer&& buffer)
                 : session(std::move(sess)), packetBuffer(std::move(buffer)) {}
             Job(Job&& other) noexcept
                 : session(std::move(other.session)), 
                   packetBuffer(std::move(other.packetBuffer)),
+                  sequence(other.sequence),
+                  receivedAtUs(other.receivedAtUs),
                   isShutdownSignal(other.isShutdownSignal) {}
             Job& operator=(Job&& other) noexcept
             {
@@ -27,6 +33,8 @@ namespace CppMMO
                 {
                     session = std::move(other.session);
                     packetBuffer = std::move(other.packetBuffer);
+                    sequence = other.sequence;
+                    receivedAtUs = other.receivedAtUs;
                     isShutdownSignal = other.isShutdownSignal;
                 }
                 return *this;
@@ -37,18 +45,37 @@ namespace CppMMO
             Job& operator=(const Job&) = delete;
         };
 
+        /**
+         * @brief Packet jobs for the JobProcessor workers, sharded by session.
+         *
+         * Each worker owns one shard and a session's jobs always land in the same shard, so its
+         * packets are dispatched in order by one thread. A worker whose shard is empty steals only
+         * from a shard holding more than `stealThreshold` jobs; that can reorder the victim's
+         * sessions, which JobProcessor counts. One shard reproduces the old shared queue.
+         */
         class JobQueue
         {
         public:
-            JobQueue();
+            explicit JobQueue(const WaitConfig& waitConfig = {}, size_t shardCount = 1, size_t stealThreshold = 0);
             void PushJob(Job job);
-            Job PopJob();
+            // Blocks for the next job of `worker`'s shard; an empty Job once shut down
+            Job PopJob(size_t worker = 0);
             void Shutdown();
             bool IsShuttingDown() const {return m_shuttingDown.load(std::memory_order_acquire);}
+            size_t GetShardCount() const { return m_shards.size(); }
         private:
-            ::moodycamel::ConcurrentQueue<Job> m_jobQueue;
-            mutable std::mutex m_mutex;
-            std::condition_variable m_condition;
+            struct Shard
+            {
+                explicit Shard(const WaitConfig& waitConfig);
+                ::moodycamel::ConcurrentQueue<Job> jobs;
+                QueueWaiter waiter;
+            };
+
+            bool TrySteal(size_t owner, Job& job);
+
+            std::vector<std::unique_ptr<Shard>> m_shards;
+            size_t m_stealThreshold;                    // 0 = never steal
+            std::atomic<size_t> m_nextUnowned{0};       // Round-robin for jobs without a session
             std::atomic<bool> m_shuttingDown = false;
         };
     }
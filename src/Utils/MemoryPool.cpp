@@ -10,9 +10,86 @@ namespace CppMMO::Utils
     static constexpr size_t DEFAULT_VECTOR_POOL_SIZE = 256;
     static constexpr size_t DEFAULT_VECTOR_CAPACITY = 200;
     static constexpr size_t DEFAULT_STRING_CACHE_SIZE = 1000;
+    static constexpr size_t DEFAULT_PACKET_SLAB_COUNT = 4096;
+    static constexpr size_t DEFAULT_PACKET_BLOCKS_PER_CLASS = 1024;
+
+    // PacketBufferAllocator Implementation
+    PacketBufferAllocator::PacketBufferAllocator(size_t maxCachedPerClass)
+        : m_maxCachedPerClass(maxCachedPerClass)
+    {
+    }
+
+    PacketBufferAllocator::~PacketBufferAllocator()
+    {
+        uint8_t* block = nullptr;
+        for (auto& freeBlocks : m_freeBlocks)
+        {
+            while (freeBlocks.try_dequeue(block))
+            {
+                delete[] block;
+            }
+        }
+    }
+
+    size_t PacketBufferAllocator::SizeClassOf(size_t size)
+    {
+        size_t sizeClass = 0;
+        while (sizeClass < SIZE_CLASS_COUNT && BlockSize(sizeClass) < size)
+        {
+            ++sizeClass;
+        }
+        return sizeClass;
+    }
+
+    uint8_t* PacketBufferAllocator::allocate(size_t size)
+    {
+        size_t sizeClass = SizeClassOf(size);
+        if (sizeClass == SIZE_CLASS_COUNT)
+        {
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            return new uint8_t[size];
+        }
+
+        uint8_t* block = nullptr;
+        if (m_freeBlocks[sizeClass].try_dequeue(block))
+        {
+            m_cachedCounts[sizeClass].fetch_sub(1, std::memory_order_relaxed);
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return block;
+        }
+
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return new uint8_t[BlockSize(sizeClass)];
+    }
+
+    void PacketBufferAllocator::deallocate(uint8_t* p, size_t size)
+    {
+        // FlatBuffers passes back the size it allocated with, so this maps to the same class
+        size_t sizeClass = SizeClassOf(size);
+        if (sizeClass == SIZE_CLASS_COUNT ||
+            m_cachedCounts[sizeClass].load(std::memory_order_relaxed) >= m_maxCachedPerClass)
+        {
+            delete[] p;
+            return;
+        }
+
+        m_cachedCounts[sizeClass].fetch_add(1, std::memory_order_relaxed);
+        m_freeBlocks[sizeClass].enqueue(p);
+    }
+
+    size_t PacketBufferAllocator::GetCachedCount() const
+    {
+        size_t total = 0;
+        for (const auto& count : m_cachedCounts)
+        {
+            total += count.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
     // FlatBufferBuilderPool Implementation
-    FlatBufferBuilderPool::FlatBufferBuilderPool(size_t poolSize, size_t initialCapacity)
-        : m_poolSize(poolSize), m_initialCapacity(initialCapacity)
+    FlatBufferBuilderPool::FlatBufferBuilderPool(size_t poolSize, size_t initialCapacity, flatbuffers::Allocator* allocator)
+        : m_poolSize(poolSize), m_initialCapacity(initialCapacity), m_allocator(allocator)
     {
         // Pre-allocate builders to avoid allocation during runtime
         std::lock_guard<std::mutex> lock(m_mutex);
@@ -68,7 +145,7 @@ namespace CppMMO::Utils
 
     std::unique_ptr<flatbuffers::FlatBufferBuilder> FlatBufferBuilderPool::CreateBuilder()
     {
-        return std::make_unique<flatbuffers::FlatBufferBuilder>(m_initialCapacity);
+        return std::make_unique<flatbuffers::FlatBufferBuilder>(m_initialCapacity, m_allocator);
     }
 
     // PooledFlatBufferBuilder Implementation
@@ -253,6 +330,91 @@ namespace CppMMO::Utils
         return *this;
     }
 
+    // PooledPacketBuffer Implementation
+    PooledPacketBuffer::~PooledPacketBuffer()
+    {
+        Reset();
+    }
+
+    PooledPacketBuffer::PooledPacketBuffer(PooledPacketBuffer&& other) noexcept
+        : m_pool(other.m_pool), m_data(other.m_data), m_size(other.m_size)
+    {
+        other.m_pool = nullptr;
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+
+    PooledPacketBuffer& PooledPacketBuffer::operator=(PooledPacketBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            // Return current slab before taking ownership from other
+            Reset();
+
+            m_pool = other.m_pool;
+            m_data = other.m_data;
+            m_size = other.m_size;
+            other.m_pool = nullptr;
+            other.m_data = nullptr;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+    void PooledPacketBuffer::Reset()
+    {
+        if (m_data)
+        {
+            if (m_pool)
+            {
+                m_pool->Release(m_data);
+            }
+            else
+            {
+                delete[] m_data;
+            }
+        }
+        m_pool = nullptr;
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    // PacketSlabPool Implementation
+    PacketSlabPool::PacketSlabPool(size_t slabCount)
+        : m_slabCount(slabCount),
+          m_arena(std::make_unique<std::byte[]>(slabCount * SLAB_SIZE)),
+          m_freeSlabs(slabCount)
+    {
+        for (size_t i = 0; i < slabCount; ++i)
+        {
+            m_freeSlabs.enqueue(m_arena.get() + i * SLAB_SIZE);
+        }
+
+        LOG_INFO("PacketSlabPool initialized with {} slabs, {} bytes each", slabCount, SLAB_SIZE);
+    }
+
+    PooledPacketBuffer PacketSlabPool::Acquire(std::span<const std::byte> packet)
+    {
+        std::byte* slab = nullptr;
+        if (packet.size() <= SLAB_SIZE && m_freeSlabs.try_dequeue(slab))
+        {
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            std::memcpy(slab, packet.data(), packet.size());
+            return PooledPacketBuffer(this, slab, packet.size());
+        }
+
+        // Oversized packet or pool exhausted: fall back to a heap buffer
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        std::byte* heapBuffer = new std::byte[packet.size()];
+        std::memcpy(heapBuffer, packet.data(), packet.size());
+        return PooledPacketBuffer(nullptr, heapBuffer, packet.size());
+    }
+
+    void PacketSlabPool::Release(std::byte* slab)
+    {
+        m_freeSlabs.enqueue(slab);
+    }
+
     // MemoryPoolManager Implementation
     MemoryPoolManager& MemoryPoolManager::Instance()
     {
@@ -261,8 +423,10 @@ namespace CppMMO::Utils
     }
 
     MemoryPoolManager::MemoryPoolManager()
-        : m_builderPool(DEFAULT_BUILDER_POOL_SIZE, DEFAULT_BUILDER_CAPACITY),
-          m_vectorPool(DEFAULT_VECTOR_POOL_SIZE, DEFAULT_VECTOR_CAPACITY)
+        : m_packetAllocator(DEFAULT_PACKET_BLOCKS_PER_CLASS),
+          m_builderPool(DEFAULT_BUILDER_POOL_SIZE, DEFAULT_BUILDER_CAPACITY, &m_packetAllocator),
+          m_vectorPool(DEFAULT_VECTOR_POOL_SIZE, DEFAULT_VECTOR_CAPACITY),
+          m_packetSlabPool(DEFAULT_PACKET_SLAB_COUNT)
     {
         // Prewarm string cache for expected player count
         m_stringCache.PrewarmCache(DEFAULT_STRING_CACHE_SIZE);
@@ -277,6 +441,11 @@ namespace CppMMO::Utils
                 m_builderPool.GetAvailableCount(), m_builderPool.GetPoolSize());
         LOG_INFO("PlayerStateVectorPool: {}/{} vectors available", 
                 m_vectorPool.GetAvailableCount(), m_vectorPool.GetPoolSize());
+        LOG_INFO("PacketSlabPool: {}/{} slabs available, hits: {}, misses: {}", 
+                m_packetSlabPool.GetAvailableCount(), m_packetSlabPool.GetPoolSize(),
+                m_packetSlabPool.GetHitCount(), m_packetSlabPool.GetMissCount());
+        LOG_INFO("PacketBufferAllocator: {} blocks cached, hits: {}, misses: {}",
+                m_packetAllocator.GetCachedCount(), m_packetAllocator.GetHitCount(), m_packetAllocator.GetMissCount());
         LOG_INFO("==============================");
     }
 }
\ No newline at end of file
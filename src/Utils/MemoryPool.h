@@ -7,6 +7,46 @@
 
 namespace CppMMO::Utils
 {
+    /**
+     * @brief FlatBuffers allocator that recycles builder buffers in power-of-two size classes
+     *
+     * Builders finish packets with FinishSizePrefixed and hand the detached buffer straight to a
+     * session. The DetachedBuffer keeps a pointer to this allocator and returns its block here
+     * once the session has written it, usually from an IO thread, so the free lists are lock-free.
+     */
+    class PacketBufferAllocator : public flatbuffers::Allocator
+    {
+    public:
+        static constexpr size_t MIN_BLOCK_SIZE = 1024;
+        static constexpr size_t SIZE_CLASS_COUNT = 7;     // 1KB .. 64KB; larger blocks bypass the pool
+
+        explicit PacketBufferAllocator(size_t maxCachedPerClass = 1024);
+        ~PacketBufferAllocator() override;
+
+        PacketBufferAllocator(const PacketBufferAllocator&) = delete;
+        PacketBufferAllocator& operator=(const PacketBufferAllocator&) = delete;
+
+        uint8_t* allocate(size_t size) override;
+        void deallocate(uint8_t* p, size_t size) override;
+
+        // Get pool statistics
+        size_t GetCachedCount() const;
+        uint64_t GetHitCount() const { return m_hits.load(std::memory_order_relaxed); }
+        uint64_t GetMissCount() const { return m_misses.load(std::memory_order_relaxed); }
+
+    private:
+        // Size class index for a request, or SIZE_CLASS_COUNT if it is too large to pool
+        static size_t SizeClassOf(size_t size);
+        static size_t BlockSize(size_t sizeClass) { return MIN_BLOCK_SIZE << sizeClass; }
+
+        const size_t m_maxCachedPerClass;
+        std::array<moodycamel::ConcurrentQueue<uint8_t*>, SIZE_CLASS_COUNT> m_freeBlocks;
+        std::array<std::atomic<size_t>, SIZE_CLASS_COUNT> m_cachedCounts{};
+
+        std::atomic<uint64_t> m_hits{0};
+        std::atomic<uint64_t> m_misses{0};
+    };
+
     /**
      * @brief Thread-safe memory pool for FlatBuffers builders to eliminate dynamic allocation
      * 
@@ -16,7 +56,8 @@ namespace CppMMO::Utils
     class FlatBufferBuilderPool
     {
     public:
-        explicit FlatBufferBuilderPool(size_t poolSize = 256, size_t initialCapacity = 1024);
+        explicit FlatBufferBuilderPool(size_t poolSize = 256, size_t initialCapacity = 1024,
+                                       flatbuffers::Allocator* allocator = nullptr);
         ~FlatBufferBuilderPool() = default;
 
         // Get a builder from the pool
@@ -32,6 +73,7 @@ namespace CppMMO::Utils
     private:
         const size_t m_poolSize;
         const size_t m_initialCapacity;
+        flatbuffers::Allocator* m_allocator;  // Not owned; null uses the FlatBuffers default allocator
         
         mutable std::mutex m_mutex;
         std::queue<std::unique_ptr<flatbuffers::FlatBufferBuilder>> m_availableBuilders;
@@ -193,6 +235,82 @@ namespace CppMMO::Utils
         std::unique_ptr<PlayerStateVectorPool::PlayerStateVector> m_vector;
     };
 
+    class PacketSlabPool;
+
+    /**
+     * @brief Move-only handle to a received packet body stored in a pooled slab
+     *
+     * Owns either a slab borrowed from a PacketSlabPool or, for oversized packets and pool
+     * misses, a heap allocation. The slab is returned to its pool when the handle is destroyed.
+     */
+    class PooledPacketBuffer
+    {
+    public:
+        PooledPacketBuffer() = default;
+        ~PooledPacketBuffer();
+
+        // Non-copyable, movable only
+        PooledPacketBuffer(const PooledPacketBuffer&) = delete;
+        PooledPacketBuffer& operator=(const PooledPacketBuffer&) = delete;
+        PooledPacketBuffer(PooledPacketBuffer&& other) noexcept;
+        PooledPacketBuffer& operator=(PooledPacketBuffer&& other) noexcept;
+
+        const std::byte* data() const { return m_data; }
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        // Returns the slab to its pool (or frees the heap fallback) ahead of destruction
+        void Reset();
+
+    private:
+        friend class PacketSlabPool;
+        PooledPacketBuffer(PacketSlabPool* pool, std::byte* data, size_t size)
+            : m_pool(pool), m_data(data), m_size(size) {}
+
+        PacketSlabPool* m_pool = nullptr;   // null when m_data is a heap fallback
+        std::byte* m_data = nullptr;
+        size_t m_size = 0;
+    };
+
+    /**
+     * @brief Lock-free pool of fixed-size slabs for incoming packet bodies
+     *
+     * All slabs are carved out of one contiguous arena at startup. IO threads copy each received
+     * frame into a slab and hand ownership to the job queue; worker threads return the slab once
+     * the packet has been dispatched, so steady-state ingress does not allocate.
+     */
+    class PacketSlabPool
+    {
+    public:
+        static constexpr size_t SLAB_SIZE = 512;  // Covers input, zone, login and typical chat packets
+
+        explicit PacketSlabPool(size_t slabCount = 4096);
+        ~PacketSlabPool() = default;
+
+        PacketSlabPool(const PacketSlabPool&) = delete;
+        PacketSlabPool& operator=(const PacketSlabPool&) = delete;
+
+        // Copies the packet body into a slab (or a heap buffer if it does not fit / pool is empty)
+        PooledPacketBuffer Acquire(std::span<const std::byte> packet);
+
+        // Get pool statistics
+        size_t GetPoolSize() const { return m_slabCount; }
+        size_t GetAvailableCount() const { return m_freeSlabs.size_approx(); }
+        uint64_t GetHitCount() const { return m_hits.load(std::memory_order_relaxed); }
+        uint64_t GetMissCount() const { return m_misses.load(std::memory_order_relaxed); }
+
+    private:
+        friend class PooledPacketBuffer;
+        void Release(std::byte* slab);
+
+        const size_t m_slabCount;
+        std::unique_ptr<std::byte[]> m_arena;
+        moodycamel::ConcurrentQueue<std::byte*> m_freeSlabs;
+
+        std::atomic<uint64_t> m_hits{0};
+        std::atomic<uint64_t> m_misses{0};
+    };
+
     /**
      * @brief Global memory pool manager
      */
@@ -202,8 +320,10 @@ namespace CppMMO::Utils
         static MemoryPoolManager& Instance();
         
         FlatBufferBuilderPool& GetBuilderPool() { return m_builderPool; }
+        PacketBufferAllocator& GetPacketAllocator() { return m_packetAllocator; }
         PlayerStateVectorPool& GetVectorPool() { return m_vectorPool; }
         StringCache& GetStringCache() { return m_stringCache; }
+        PacketSlabPool& GetPacketSlabPool() { return m_packetSlabPool; }
         
         // Get pooled builder with RAII wrapper
         PooledFlatBufferBuilder GetPooledBuilder() { return PooledFlatBufferBuilder(m_builderPool); }
@@ -217,8 +337,10 @@ namespace CppMMO::Utils
     private:
         MemoryPoolManager();
         
+        PacketBufferAllocator m_packetAllocator;  // Must outlive the builders and every detached buffer
         FlatBufferBuilderPool m_builderPool;
         PlayerStateVectorPool m_vectorPool;
         StringCache m_stringCache;
+        PacketSlabPool m_packetSlabPool;
     };
 }
\ No newline at end of file
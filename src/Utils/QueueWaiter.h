@@ -0,0 +1,157 @@
+#pragma once
+// Standard headers only, so bench/QueueWaitBench.cpp can include it without the server's pch
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace CppMMO
+{
+    namespace Utils
+    {
+        enum class WaitStrategy
+        {
+            Blocking,       // Mutex + condition variable; every push locks and notifies
+            SpinThenPark    // Consumers spin, then park on a futex-backed eventcount; pushes signal only parked consumers
+        };
+
+        struct WaitConfig
+        {
+            WaitStrategy strategy = WaitStrategy::SpinThenPark;
+            uint32_t spin_iterations = 2000;    // SpinThenPark: failed pops before a consumer parks
+        };
+
+        inline void CpuRelax()
+        {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+            _mm_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#endif
+        }
+
+        /**
+         * @brief Wakeup side of a lock-free MPMC queue (JobQueue, GameLogicQueue).
+         *
+         * SpinThenPark is an eventcount: a consumer registers as a waiter, samples the epoch,
+         * re-checks the queue and only then sleeps on the epoch with std::atomic::wait (a futex on
+         * Linux). A producer pays one fence and one load when nobody is parked; it bumps the epoch
+         * and wakes a consumer only when the waiter count says someone is (about to be) asleep.
+         * The registration RMW and the producer's fence order the two sides, so a push can never
+         * slip between a consumer's last check and its sleep.
+         */
+        class QueueWaiter
+        {
+        public:
+            explicit QueueWaiter(const WaitConfig& config = {}) : m_config(config) {}
+
+            // Call after every enqueue
+            void Notify()
+            {
+                if (m_config.strategy == WaitStrategy::Blocking)
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.notify_one();
+                    return;
+                }
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (m_waiters.load(std::memory_order_relaxed) > 0)
+                {
+                    m_epoch.fetch_add(1, std::memory_order_release);
+                    m_epoch.notify_one();
+                }
+            }
+
+            // Call after setting the queue's shutdown flag
+            void NotifyAll()
+            {
+                if (m_config.strategy == WaitStrategy::Blocking)
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.notify_all();
+                    return;
+                }
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                m_epoch.fetch_add(1, std::memory_order_release);
+                m_epoch.notify_all();
+            }
+
+            /**
+             * @brief Blocks until tryPop() succeeds or `stop` is set.
+             *
+             * @return true if tryPop() produced an item, false if woken by `stop` with the queue empty.
+             */
+            template <typename TryPop>
+            bool Wait(TryPop&& tryPop, const std::atomic<bool>& stop)
+            {
+                if (m_config.strategy == WaitStrategy::Blocking)
+                {
+                    bool popped = false;
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.wait(lock, [&]
+                    {
+                        popped = tryPop();
+                        return popped || stop.load(std::memory_order_acquire);
+                    });
+                    return popped;
+                }
+
+                while (true)
+                {
+                    for (uint32_t i = 0; i < m_config.spin_iterations; ++i)
+                    {
+                        if (tryPop())
+                        {
+                            return true;
+                        }
+                        if (stop.load(std::memory_order_acquire))
+                        {
+                            return false;
+                        }
+                        // Yield now and then so an oversubscribed host still runs the producers
+                        if ((i & 63) == 63)
+                        {
+                            std::this_thread::yield();
+                        }
+                        else
+                        {
+                            CpuRelax();
+                        }
+                    }
+
+                    m_waiters.fetch_add(1, std::memory_order_seq_cst);
+                    uint32_t epoch = m_epoch.load(std::memory_order_seq_cst);
+                    if (tryPop())
+                    {
+                        m_waiters.fetch_sub(1, std::memory_order_relaxed);
+                        return true;
+                    }
+                    if (stop.load(std::memory_order_acquire))
+                    {
+                        m_waiters.fetch_sub(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                    m_epoch.wait(epoch, std::memory_order_acquire);
+                    m_waiters.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+
+            const WaitConfig& GetConfig() const { return m_config; }
+
+        private:
+            WaitConfig m_config;
+
+            // Blocking
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+
+            // SpinThenPark
+            std::atomic<uint32_t> m_waiters{0};
+            std::atomic<uint32_t> m_epoch{0};
+        };
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+// Standard headers only, so the benches can include it without the server's pch
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace CppMMO
+{
+    namespace Utils
+    {
+        /**
+         * @brief Bounded lock-free ring for exactly one producer thread and one consumer thread.
+         *
+         * Records are copied in and out, so T must be trivially copyable. Each side keeps its own
+         * index on its own cache line together with a cached copy of the other side's index, and
+         * only re-reads the shared index when the cached one says the ring is full (producer) or
+         * empty (consumer).
+         */
+        template <typename T, size_t Capacity>
+        class SpscRing
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "SpscRing copies records with plain assignment");
+            static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+        public:
+            // Producer thread only; false when the ring is full
+            bool TryPush(const T& item)
+            {
+                size_t head = m_head.load(std::memory_order_relaxed);
+                if (head - m_cachedTail == Capacity)
+                {
+                    m_cachedTail = m_tail.load(std::memory_order_acquire);
+                    if (head - m_cachedTail == Capacity)
+                    {
+                        return false;
+                    }
+                }
+                m_slots[head & (Capacity - 1)] = item;
+                m_head.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+            // Consumer thread only; copies up to `max` records into `out` and returns the count
+            size_t TryPopBulk(T* out, size_t max)
+            {
+                size_t tail = m_tail.load(std::memory_order_relaxed);
+                if (m_cachedHead == tail)
+                {
+                    m_cachedHead = m_head.load(std::memory_order_acquire);
+                }
+                size_t count = std::min(m_cachedHead - tail, max);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    out[i] = m_slots[(tail + i) & (Capacity - 1)];
+                }
+                if (count > 0)
+                {
+                    m_tail.store(tail + count, std::memory_order_release);
+                }
+                return count;
+            }
+
+            size_t SizeApprox() const
+            {
+                return m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_relaxed);
+            }
+
+            static constexpr size_t GetCapacity() { return Capacity; }
+
+        private:
+            // Producer side
+            alignas(64) std::atomic<size_t> m_head{0};
+            size_t m_cachedTail = 0;
+            // Consumer side
+            alignas(64) std::atomic<size_t> m_tail{0};
+            size_t m_cachedHead = 0;
+            alignas(64) T m_slots[Capacity];
+        };
+    }
+}
@@ -5,10 +5,12 @@
 #include "Network/TcpServer.h"
 #include "Network/PacketManager.h"
 #include "Network/SessionManager.h"
+#include "Network/UdpChannel.h"
 #include "Game/GameLogicQueue.h"
 #include "Game/Managers/GameManager.h"
 #include "Game/PacketHandlers/LoginPacketHandler.h"
 #include "Game/PacketHandlers/ChatPacketHandler.h"
+#include "Game/PacketHandlers/HeartbeatPacketHandler.h"
 #include "Game/Managers/ChatManager.h"
 #include "Game/Services/AuthService.h"
 #include <boost/program_options.hpp>
@@ -31,7 +33,9 @@ int main(int argc, char* argv[])
         ("help,h", "Print Help Message.")
         ("port,p", po::value<unsigned short>()->default_value(8080), "Set Server Port.")
         ("io-threads", po::value<int>()->default_value(2), "Set number of network I/O threads.")
+        ("io-mode", po::value<std::string>()->default_value("shared"), "Network I/O layout: shared (one io_context), per-core (one io_context per I/O thread) or busy-poll (per-core, threads spin before blocking).")
         ("logic-threads", po::value<int>()->default_value(4), "Set number of logic processing threads.")
+        ("takeover", po::bool_switch(), "Take listening sockets and sessions over from the running server (needs network.handover_socket_path).")
         ("server-config", po::value<std::string>()->default_value("config/server_config.json"), "Server configuration file path.");
 
     po::variables_map vm;
@@ -58,10 +62,37 @@ int main(int argc, char* argv[])
     int ioThreadCount = vm["io-threads"].as<int>();
     int logicThreadCount = vm["logic-threads"].as<int>();
     std::string serverConfigPath = vm["server-config"].as<std::string>();
+    std::string ioMode = vm["io-mode"].as<std::string>();
+    bool takeover = vm["takeover"].as<bool>();
+    if (ioMode != "shared" && ioMode != "per-core" && ioMode != "busy-poll")
+    {
+        std::cerr << "Error: --io-mode must be 'shared', 'per-core' or 'busy-poll'" << std::endl;
+        return 1;
+    }
 
     // Load server configuration
     std::string authHost = "localhost";
     std::string authPort = "5278";
+    CppMMO::Network::SessionConfig sessionConfig;
+    bool reusePort = true;
+    std::chrono::milliseconds reaperInterval{1000};
+    size_t registeredReceiveChunks = 1024;
+    size_t maxConnections = 600;
+    int listenBacklog = 1024;
+    size_t acceptConcurrency = 4;
+    bool inlineGamePackets = true;
+    size_t inlineMaxPacketBytes = 256;
+    CppMMO::Network::AdmissionConfig admissionConfig;
+    std::chrono::microseconds busyPollWindow{200};
+    std::string handoverSocketPath;
+    bool handoverSessions = true;
+    std::chrono::milliseconds handoverDrainTimeout{500};
+    bool udpSnapshots = false;
+    unsigned short udpPort = 8081;
+    size_t udpMaxDatagramBytes = 1200;
+    CppMMO::Utils::WaitConfig queueWaitConfig;
+    bool shardJobsBySession = true;
+    size_t jobStealThreshold = 256;
     
     try {
         std::ifstream serverConfigFile(serverConfigPath);
@@ -71,6 +102,72 @@ int main(int argc, char* argv[])
             
             authHost = serverConfig["auth_server"]["host"].get<std::string>();
             authPort = std::to_string(serverConfig["auth_server"]["port"].get<int>());
+
+            if (serverConfig.contains("network")) {
+                const auto& network = serverConfig["network"];
+                reusePort = network.value("reuse_port", reusePort);
+                sessionConfig.read_idle_timeout = std::chrono::milliseconds(
+                    network.value("read_idle_timeout_ms", static_cast<int64_t>(sessionConfig.read_idle_timeout.count())));
+                sessionConfig.write_stall_timeout = std::chrono::milliseconds(
+                    network.value("write_stall_timeout_ms", static_cast<int64_t>(sessionConfig.write_stall_timeout.count())));
+                sessionConfig.compression_threshold_bytes = network.value("compression_threshold_bytes", sessionConfig.compression_threshold_bytes);
+                sessionConfig.zerocopy_threshold_bytes = network.value("zerocopy_threshold_bytes", sessionConfig.zerocopy_threshold_bytes);
+                sessionConfig.ingress.enabled = network.value("ingress_rate_limit", sessionConfig.ingress.enabled);
+                sessionConfig.ingress.max_frame_bytes = network.value("max_ingress_frame_bytes", sessionConfig.ingress.max_frame_bytes);
+                if (network.contains("ingress_limits")) {
+                    const auto& limits = network["ingress_limits"];
+                    const std::pair<const char*, CppMMO::Network::IngressClass> classes[] = {
+                        {"input", CppMMO::Network::IngressClass::Input},
+                        {"chat", CppMMO::Network::IngressClass::Chat},
+                        {"control", CppMMO::Network::IngressClass::Control},
+                    };
+                    for (const auto& [name, ingressClass] : classes) {
+                        if (!limits.contains(name)) continue;
+                        const auto& entry = limits[name];
+                        auto& limit = sessionConfig.ingress.limits[static_cast<size_t>(ingressClass)];
+                        limit.packets_per_second = entry.value("packets_per_second", limit.packets_per_second);
+                        limit.packet_burst = entry.value("packet_burst", limit.packet_burst);
+                        limit.bytes_per_second = entry.value("bytes_per_second", limit.bytes_per_second);
+                        limit.byte_burst = entry.value("byte_burst", limit.byte_burst);
+                    }
+                }
+                registeredReceiveChunks = network.value("registered_receive_chunks", registeredReceiveChunks);
+                listenBacklog = network.value("listen_backlog", listenBacklog);
+                acceptConcurrency = network.value("accept_concurrency", acceptConcurrency);
+                inlineGamePackets = network.value("inline_game_packets", inlineGamePackets);
+                inlineMaxPacketBytes = network.value("inline_max_packet_bytes", inlineMaxPacketBytes);
+                if (network.contains("admission")) {
+                    const auto& admission = network["admission"];
+                    admissionConfig.accept_rate_per_second = admission.value("accept_rate_per_second", admissionConfig.accept_rate_per_second);
+                    admissionConfig.accept_burst = admission.value("accept_burst", admissionConfig.accept_burst);
+                    admissionConfig.per_ip_max_connections = admission.value("per_ip_max_connections", admissionConfig.per_ip_max_connections);
+                    admissionConfig.per_ip_connect_rate_per_second = admission.value("per_ip_connect_rate_per_second", admissionConfig.per_ip_connect_rate_per_second);
+                    admissionConfig.per_ip_connect_burst = admission.value("per_ip_connect_burst", admissionConfig.per_ip_connect_burst);
+                    admissionConfig.exempt_loopback = admission.value("exempt_loopback", admissionConfig.exempt_loopback);
+                }
+                busyPollWindow = std::chrono::microseconds(
+                    network.value("busy_poll_window_us", static_cast<int64_t>(busyPollWindow.count())));
+                sessionConfig.socket_busy_poll_us = network.value("socket_busy_poll_us", sessionConfig.socket_busy_poll_us);
+                handoverSocketPath = network.value("handover_socket_path", handoverSocketPath);
+                handoverSessions = network.value("handover_sessions", handoverSessions);
+                handoverDrainTimeout = std::chrono::milliseconds(
+                    network.value("handover_drain_timeout_ms", static_cast<int64_t>(handoverDrainTimeout.count())));
+                reaperInterval = std::chrono::milliseconds(
+                    network.value("reaper_interval_ms", static_cast<int64_t>(reaperInterval.count())));
+                udpSnapshots = network.value("udp_snapshots", udpSnapshots);
+                udpPort = network.value("udp_port", udpPort);
+                udpMaxDatagramBytes = network.value("udp_max_datagram_bytes", udpMaxDatagramBytes);
+            }
+
+            if (serverConfig.contains("queues")) {
+                const auto& queues = serverConfig["queues"];
+                if (queues.value("wait_strategy", std::string("spin_then_park")) == "blocking") {
+                    queueWaitConfig.strategy = CppMMO::Utils::WaitStrategy::Blocking;
+                }
+                queueWaitConfig.spin_iterations = queues.value("spin_iterations", queueWaitConfig.spin_iterations);
+                shardJobsBySession = queues.value("shard_jobs_by_session", shardJobsBySession);
+                jobStealThreshold = queues.value("job_steal_threshold", jobStealThreshold);
+            }
             
             LOG_INFO("Server config loaded from: {}", serverConfigPath);
         } else {
@@ -80,25 +177,72 @@ int main(int argc, char* argv[])
         LOG_ERROR("Failed to load server config: {}, using defaults", e.what());
     }
 
-    LOG_INFO("Server configured: Port={}, IO Threads={}, Logic Threads={}", port, ioThreadCount, logicThreadCount);
+    // Player-facing network policy sits with the gameplay settings in game_config.json (the file
+    // GameManager reads). server_config.json keeps transport and deployment tuning, which differs
+    // per deployment and is picked with --server-config (server_config.docker.json under compose).
+    const std::string gameConfigPath = "config/game_config.json";
+    try {
+        std::ifstream gameConfigFile(gameConfigPath);
+        if (gameConfigFile.is_open()) {
+            nlohmann::json gameConfig;
+            gameConfigFile >> gameConfig;
+
+            if (gameConfig.contains("network")) {
+                const auto& network = gameConfig["network"];
+                maxConnections = network.value("max_concurrent_connections", maxConnections);
+                sessionConfig.send_budget_bytes = network.value("session_send_budget_bytes", sessionConfig.send_budget_bytes);
+                sessionConfig.slow_consumer_grace = std::chrono::milliseconds(
+                    network.value("slow_consumer_grace_ms", static_cast<int64_t>(sessionConfig.slow_consumer_grace.count())));
+                if (network.value("slow_consumer_policy", std::string("drop_snapshots")) == "disconnect") {
+                    sessionConfig.slow_consumer_policy = CppMMO::Network::SlowConsumerPolicy::Disconnect;
+                }
+            }
+        } else {
+            LOG_WARN("Could not open game config file: {}, using default network policy", gameConfigPath);
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("Failed to load network policy from {}: {}, using defaults", gameConfigPath, e.what());
+    }
+
+    LOG_INFO("Server configured: Port={}, IO Threads={}, IO Mode={}, Logic Threads={}", port, ioThreadCount, ioMode, logicThreadCount);
     LOG_INFO("Auth Service configured: Host={}, Port={}", authHost, authPort);
 
     try
     {
         asio::io_context io_context;
 
-        auto jobQueue = std::make_shared<CppMMO::Utils::JobQueue>();
-        auto packetManager = std::make_shared<CppMMO::Network::PacketManager>(jobQueue);
-        auto gameLogicQueue = std::make_shared<CppMMO::Game::GameLogicQueue>();
+        // One shard per logic thread keeps each session's packets on one worker, in order
+        auto jobQueue = std::make_shared<CppMMO::Utils::JobQueue>(queueWaitConfig,
+            shardJobsBySession ? static_cast<size_t>(logicThreadCount) : 1, jobStealThreshold);
+        auto packetManager = std::make_shared<CppMMO::Network::PacketManager>(jobQueue, inlineMaxPacketBytes);
+        auto gameLogicQueue = std::make_shared<CppMMO::Game::GameLogicQueue>(queueWaitConfig);
         auto sessionManager = std::make_shared<CppMMO::Network::SessionManager>(gameLogicQueue);
         auto jobProcessor = std::make_shared<CppMMO::Utils::JobProcessor>(jobQueue, packetManager, gameLogicQueue);
         auto gameManager = std::make_shared<CppMMO::Game::Managers::GameManager>(gameLogicQueue, sessionManager);
         auto authService = std::make_shared<CppMMO::Game::Services::AuthService>(io_context, authHost, authPort);
 
+        std::shared_ptr<CppMMO::Network::UdpChannel> udpChannel;
+        if (udpSnapshots)
+        {
+            udpChannel = std::make_shared<CppMMO::Network::UdpChannel>(io_context, udpPort, udpMaxDatagramBytes);
+            if (udpChannel->Start())
+            {
+                gameManager->SetUdpChannel(udpChannel);
+            }
+            else
+            {
+                LOG_WARN("UDP snapshot channel disabled; snapshots stay on TCP.");
+                udpChannel.reset();
+            }
+        }
+
+        // Shared mode runs every I/O thread on one io_context; the other modes give each thread its own
+        gameManager->SetIoThreadsPerContext(ioMode == "shared" ? static_cast<size_t>(ioThreadCount) : 1);
+
         jobProcessor->Start(logicThreadCount);
         gameManager->Start();
 
-        auto loginHandlerInstance = std::make_shared<CppMMO::Game::PacketHandlers::LoginPacketHandler>(io_context, authService);
+        auto loginHandlerInstance = std::make_shared<CppMMO::Game::PacketHandlers::LoginPacketHandler>(io_context, authService, udpChannel);
         packetManager->RegisterHandler(CppMMO::Protocol::PacketId_C_Login,
             [loginHandlerInstance](std::shared_ptr<CppMMO::Network::ISession> session, const CppMMO::Protocol::UnifiedPacket* unifiedPacket) {
                 (*loginHandlerInstance)(session, unifiedPacket); 
@@ -108,13 +252,52 @@ int main(int argc, char* argv[])
             [chatHandlerInstance](std::shared_ptr<CppMMO::Network::ISession> session, const CppMMO::Protocol::UnifiedPacket* unifiedPacket) {
                 (*chatHandlerInstance)(session, unifiedPacket);
             }); 
+        auto heartbeatHandlerInstance = std::make_shared<CppMMO::Game::PacketHandlers::HeartbeatPacketHandler>();
+        packetManager->RegisterHandler(CppMMO::Protocol::PacketId_C_Heartbeat,
+            [heartbeatHandlerInstance](std::shared_ptr<CppMMO::Network::ISession> session, const CppMMO::Protocol::UnifiedPacket* unifiedPacket) {
+                (*heartbeatHandlerInstance)(session, unifiedPacket);
+            });
+        if (inlineGamePackets)
+        {
+            // Movement input goes straight from the I/O thread to the GameLogicQueue; login, chat and
+            // zone changes stay on the workers so they keep their order relative to each other
+            std::weak_ptr<CppMMO::Utils::JobProcessor> weakJobProcessor = jobProcessor;
+            packetManager->RegisterInlineHandler(CppMMO::Protocol::PacketId_C_PlayerInput,
+                [weakJobProcessor](std::shared_ptr<CppMMO::Network::ISession> session, const CppMMO::Protocol::UnifiedPacket* unifiedPacket) {
+                    if (auto processor = weakJobProcessor.lock())
+                    {
+                        processor->PushGameCommand(session, unifiedPacket, CppMMO::Game::GetSteadyMicros());
+                    }
+                });
+        }
 
         auto server = std::make_shared<CppMMO::Network::TcpServer>(io_context, port, packetManager, sessionManager);
 
         CppMMO::Game::Managers::ChatManager::GetInstance().Initialize(server);
+        server->SetHandoverHandlers(
+            [gameManager]() { return gameManager->ExportHandoverState(); },
+            [gameManager](const nlohmann::json& state, const std::unordered_map<uint64_t, uint64_t>& sessionByPlayer) {
+                gameManager->ImportHandoverState(state, sessionByPlayer);
+            });
 
         CppMMO::Network::ServiceConfig config;
         config.worker_threads = ioThreadCount;
+        config.io_mode = ioMode == "per-core" ? CppMMO::Network::IoMode::PerCore
+                       : ioMode == "busy-poll" ? CppMMO::Network::IoMode::BusyPoll
+                       : CppMMO::Network::IoMode::Shared;
+        config.reuse_port = reusePort;
+        config.reaper_interval = reaperInterval;
+        config.registered_receive_chunks = registeredReceiveChunks;
+        config.max_connections = maxConnections;
+        config.listen_backlog = listenBacklog;
+        config.accept_concurrency = acceptConcurrency;
+        config.admission = admissionConfig;
+        config.busy_poll_window = busyPollWindow;
+        config.handover_socket_path = handoverSocketPath;
+        config.takeover = takeover;
+        config.handover_sessions = handoverSessions;
+        config.handover_drain_timeout = handoverDrainTimeout;
+        config.session = sessionConfig;
         if (!server->Start(config))
         {
             LOG_CRITICAL("Server failed to start.");
@@ -129,6 +312,10 @@ int main(int argc, char* argv[])
 
         gameManager->Stop();
         jobProcessor->Stop();
+        if (udpChannel)
+        {
+            udpChannel->Stop();
+        }
         LOG_INFO("Server stopped.");
     }
     catch (const std::exception& e)